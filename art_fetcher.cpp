@@ -0,0 +1,190 @@
+// ============================================================================
+// ART_FETCHER.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "art_fetcher.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <urlmon.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+
+#pragma comment(lib, "urlmon.lib")
+namespace fs = std::filesystem;
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+static const char* const DEFAULT_ART_BASE = "https://cdn.akamai.steamstatic.com/steam/apps/";
+static const int         BACKOFF_MS[]     = { 500, 1500 };   // before attempts 2 and 3
+static_assert(sizeof(BACKOFF_MS) / sizeof(BACKOFF_MS[0]) == ArtFetcher::MAX_ATTEMPTS - 1, "one delay per retry");
+
+ArtFetcher& Art() {
+    static ArtFetcher fetcher;
+    return fetcher;
+}
+
+// ─── Configuration ───────────────────────────────────────────────────────────
+
+// Scan threads call this concurrently; the static is built once, under the
+// language's initialisation guard, and never written again.
+const std::string& ArtFetcher::BaseUrl() {
+    static const std::string url = [] {
+        const char* env = getenv("QSHELL_ART_BASE_URL");
+        std::string u = (env && *env) ? env : DEFAULT_ART_BASE;
+        if (u.back() != '/') u += '/';
+        return u;
+    }();
+    return url;
+}
+
+// ─── Queue ───────────────────────────────────────────────────────────────────
+
+void ArtFetcher::Fetch(const std::string& url, const std::string& dest, const std::string& tag) {
+    std::error_code ec;
+    if (url.empty() || fs::exists(dest, ec)) return;
+
+    std::lock_guard<std::mutex> l(m_mutex);
+    if (m_stop) return;
+    if (m_threads.empty())
+        for (unsigned i = 0; i < MAX_TRANSFERS; i++) m_threads.emplace_back(&ArtFetcher::WorkerLoop, this);
+
+    auto it = m_jobs.find(url);
+    if (it != m_jobs.end()) {
+        // Same URL already queued or downloading: ride along.
+        for (auto& w : it->second.waiters) if (w.dest == dest) return;
+        it->second.waiters.push_back({ dest, tag });
+        return;
+    }
+    m_jobs[url] = { url, { { dest, tag } } };
+    m_queue.push_back(url);
+    m_cv.notify_one();
+}
+
+void ArtFetcher::Import(const std::string& src, const std::string& dest, const std::string& tag) {
+    std::error_code ec;
+    if (fs::exists(dest, ec)) return;
+    fs::create_directories(fs::path(dest).parent_path(), ec);
+    std::string tmp = dest + "." + std::to_string(GetCurrentThreadId()) + ".part";
+    bool ok = CopyFileA(src.c_str(), tmp.c_str(), FALSE) &&
+              MoveFileExA(tmp.c_str(), dest.c_str(), MOVEFILE_REPLACE_EXISTING);
+    if (!ok) { DeleteFileA(tmp.c_str()); return; }
+    std::lock_guard<std::mutex> l(m_doneMutex);
+    m_done.push_back({ tag, dest, true });
+}
+
+void ArtFetcher::Stop() {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    for (auto& t : m_threads) if (t.joinable()) t.join();
+    m_threads.clear();
+}
+
+void ArtFetcher::DispatchCompletions() {
+    std::vector<ArtResult> done;
+    {
+        std::lock_guard<std::mutex> l(m_doneMutex);
+        if (m_done.empty()) return;
+        done.swap(m_done);
+    }
+    if (m_listener) for (auto& r : done) m_listener(r);
+}
+
+// ─── Transfers ───────────────────────────────────────────────────────────────
+
+// Lets Stop() abort a transfer mid-flight instead of waiting on the network.
+class AbortCallback : public IBindStatusCallback {
+public:
+    explicit AbortCallback(const std::atomic<bool>& stop) : m_stop(stop) {}
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (riid == IID_IUnknown || riid == IID_IBindStatusCallback) { *ppv = this; return S_OK; }
+        *ppv = nullptr; return E_NOINTERFACE;
+    }
+    ULONG STDMETHODCALLTYPE AddRef() override  { return 1; }   // stack-owned
+    ULONG STDMETHODCALLTYPE Release() override { return 1; }
+    HRESULT STDMETHODCALLTYPE OnProgress(ULONG, ULONG, ULONG, LPCWSTR) override {
+        return m_stop ? E_ABORT : S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnStartBinding(DWORD, IBinding*) override       { return S_OK; }
+    HRESULT STDMETHODCALLTYPE GetPriority(LONG*) override                     { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE OnLowResource(DWORD) override                   { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnStopBinding(HRESULT, LPCWSTR) override        { return S_OK; }
+    HRESULT STDMETHODCALLTYPE GetBindInfo(DWORD*, BINDINFO*) override         { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE OnDataAvailable(DWORD, DWORD, FORMATETC*, STGMEDIUM*) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnObjectAvailable(REFIID, IUnknown*) override   { return S_OK; }
+private:
+    const std::atomic<bool>& m_stop;
+};
+
+bool ArtFetcher::Download(const std::string& url, const std::string& dest) {
+    std::error_code ec;
+    fs::create_directories(fs::path(dest).parent_path(), ec);
+
+    // Unique per thread so two transfers never share a temp file.
+    std::string tmp = dest + "." + std::to_string(GetCurrentThreadId()) + ".part";
+    AbortCallback cb(m_stop);
+    HRESULT hr = URLDownloadToFileA(nullptr, url.c_str(), tmp.c_str(), 0, &cb);
+    if (FAILED(hr) || fs::file_size(tmp, ec) == 0 || ec) { DeleteFileA(tmp.c_str()); return false; }
+    if (!MoveFileExA(tmp.c_str(), dest.c_str(), MOVEFILE_REPLACE_EXISTING)) { DeleteFileA(tmp.c_str()); return false; }
+    return true;
+}
+
+void ArtFetcher::WorkerLoop() {
+    for (;;) {
+        std::string url;
+        {
+            std::unique_lock<std::mutex> l(m_mutex);
+            m_cv.wait(l, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            url = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        std::string first;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            first = m_jobs[url].waiters.front().dest;
+        }
+
+        bool ok = false;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS && !ok; attempt++) {
+            if (attempt > 0) {
+                // Interruptible backoff: Stop() wakes us immediately.
+                std::unique_lock<std::mutex> l(m_mutex);
+                if (m_cv.wait_for(l, std::chrono::milliseconds(BACKOFF_MS[attempt - 1]), [this] { return m_stop.load(); }))
+                    return;
+            }
+            ok = Download(url, first);
+        }
+        if (!ok) DebugLog("[art] giving up on " + url);
+
+        // Late joiners were appended under the lock while we downloaded.
+        std::vector<Waiter> waiters;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            waiters = std::move(m_jobs[url].waiters);
+            m_jobs.erase(url);
+        }
+        std::vector<ArtResult> results;
+        for (auto& w : waiters) {
+            bool wok = ok;
+            if (ok && w.dest != first) {
+                // Same temp-then-rename as Import: a reader never sees half a file.
+                std::string tmp = w.dest + "." + std::to_string(GetCurrentThreadId()) + ".part";
+                wok = CopyFileA(first.c_str(), tmp.c_str(), FALSE) &&
+                      MoveFileExA(tmp.c_str(), w.dest.c_str(), MOVEFILE_REPLACE_EXISTING);
+                if (!wok) DeleteFileA(tmp.c_str());
+            }
+            results.push_back({ w.tag, w.dest, wok });
+        }
+        std::lock_guard<std::mutex> l(m_doneMutex);
+        for (auto& r : results) m_done.push_back(std::move(r));
+    }
+}
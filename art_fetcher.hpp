@@ -0,0 +1,82 @@
+// ============================================================================
+// ART_FETCHER.HPP - Q-SHELL v3.0
+// Background artwork download service.
+//
+// A fixed number of transfer threads pull from one queue. Requests for a URL
+// that is already queued or downloading are folded into the existing
+// transfer. Failed transfers are retried with exponential backoff. Every
+// download lands in a temp file next to its destination and is renamed into
+// place, so a reader never sees a half-written image.
+//
+// Completions are not delivered on the transfer threads: they are queued and
+// handed to the listener from DispatchCompletions(), which the UI calls once
+// per frame, so the listener can touch D2D and the library directly.
+//
+// The CDN base URL can be overridden with the QSHELL_ART_BASE_URL environment
+// variable (e.g. http://127.0.0.1:8000/) to run against a local stand-in.
+// ============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct ArtResult {
+    std::string tag;    // caller's key (game name)
+    std::string dest;   // final file path
+    bool        ok = false;
+};
+
+class ArtFetcher {
+public:
+    using Listener = std::function<void(const ArtResult&)>;
+
+    ~ArtFetcher() { Stop(); }
+
+    // Queues url -> dest. No-op if dest already exists. Threads start lazily.
+    void Fetch(const std::string& url, const std::string& dest, const std::string& tag);
+
+    // Copies a local file into place on the calling thread and reports it
+    // like a finished download. No-op if dest already exists.
+    void Import(const std::string& src, const std::string& dest, const std::string& tag);
+
+    // UI thread: delivers finished transfers to the listener.
+    void SetListener(Listener l) { m_listener = std::move(l); }
+    void DispatchCompletions();
+
+    // Abandons queued work and aborts transfers in flight.
+    void Stop();
+
+    // Read once per process; always ends with '/'.
+    static const std::string& BaseUrl();
+
+    static const unsigned MAX_TRANSFERS = 4;
+    static const int      MAX_ATTEMPTS  = 3;
+
+private:
+    struct Waiter { std::string dest, tag; };
+    struct Job    { std::string url; std::vector<Waiter> waiters; };
+
+    void WorkerLoop();
+    bool Download(const std::string& url, const std::string& dest);
+
+    std::mutex                                  m_mutex;
+    std::condition_variable                     m_cv;
+    std::deque<std::string>                     m_queue;      // urls, FIFO
+    std::unordered_map<std::string, Job>        m_jobs;       // url -> queued or in flight
+    std::vector<std::thread>                    m_threads;
+    std::atomic<bool>                           m_stop{ false };
+
+    std::mutex             m_doneMutex;
+    std::vector<ArtResult> m_done;
+    Listener               m_listener;
+};
+
+ArtFetcher& Art();
@@ -0,0 +1,187 @@
+// ============================================================================
+// ART_STORE.CPP - Q-SHELL v3.0
+//
+// Manifest format (profile\art_manifest.txt), one key per line after a header:
+//   QART1
+//   key|hash|w|h|ext          (key and hash as 16 hex digits)
+// ============================================================================
+
+#include "art_store.hpp"
+#include "library_index.hpp"
+#include "image_info.hpp"
+#include "mapped_file.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+static const char* const ART_MANIFEST_MAGIC = "QART1";
+
+ArtStore& Posters() {
+    static ArtStore store;
+    return store;
+}
+
+// ─── Keys and hashes ─────────────────────────────────────────────────────────
+
+uint64_t ArtStore::KeyFor(const GameInfo& g) {
+    uint64_t k = LibraryIndex::IdKey(g);
+    return k ? k : LibraryIndex::ExeKey(g.exePath);
+}
+
+uint64_t ArtStore::HashFile(const std::string& path) {
+    MappedFile f;
+    if (!f.Open(path) || f.Size() == 0) return 0;
+    return LibraryIndex::HashBytes(f.Data(), f.Size());
+}
+
+static std::string Hex(uint64_t v) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016" PRIx64, v);
+    return buf;
+}
+
+std::string ArtStore::KeyString(uint64_t key) { return Hex(key); }
+
+uint64_t ArtStore::ParseKey(const std::string& s) {
+    uint64_t k = 0;
+    return sscanf(s.c_str(), "%" SCNx64, &k) == 1 ? k : 0;
+}
+
+std::string ArtStore::PathOf(const ArtEntry& e) const {
+    return m_dir + "\\" + Hex(e.hash) + e.ext;
+}
+
+std::string ArtStore::IncomingPath(uint64_t key, const std::string& ext) const {
+    return m_dir + "\\incoming\\" + Hex(key) + ext;
+}
+
+// ─── Manifest ────────────────────────────────────────────────────────────────
+
+bool ArtStore::Load(const std::string& manifestPath, const std::string& storeDir) {
+    std::lock_guard<std::mutex> l(m_mutex);
+    m_manifest = manifestPath;
+    m_dir      = storeDir;
+    m_entries.clear();
+    m_refs.clear();
+    m_loaded = false;
+
+    // Downloads that never got filed (the shell quit mid-transfer).
+    std::error_code ec;
+    fs::remove_all(m_dir + "\\incoming", ec);
+
+    std::ifstream f(manifestPath);
+    std::string   line;
+    if (!f || !std::getline(f, line) || line != ART_MANIFEST_MAGIC) return false;
+    m_loaded = true;
+
+    while (std::getline(f, line)) {
+        uint64_t key, hash;
+        int      w, h;
+        char     ext[6] = {};
+        if (sscanf(line.c_str(), "%" SCNx64 "|%" SCNx64 "|%d|%d|%5s", &key, &hash, &w, &h, ext) != 5) continue;
+        ArtEntry e;
+        e.hash = hash; e.w = w; e.h = h;
+        memcpy(e.ext, ext, sizeof(e.ext));
+        if (m_entries.emplace(key, e).second) m_refs[hash]++;
+    }
+    return true;
+}
+
+bool ArtStore::Save() {
+    std::lock_guard<std::mutex> l(m_mutex);
+    if ((!m_dirty && m_loaded) || m_manifest.empty()) return true;
+    std::error_code ec;
+    fs::create_directories(fs::path(m_manifest).parent_path(), ec);
+
+    std::string tmp = m_manifest + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f) return false;
+        f << ART_MANIFEST_MAGIC << "\n";
+        for (auto& [k, e] : m_entries)
+            f << Hex(k) << "|" << Hex(e.hash) << "|" << e.w << "|" << e.h << "|" << e.ext << "\n";
+        if (!f) return false;
+    }
+    fs::rename(tmp, m_manifest, ec);
+    if (!ec) m_dirty = false, m_loaded = true;
+    return !ec;
+}
+
+// ─── Store ───────────────────────────────────────────────────────────────────
+
+bool ArtStore::Ingest(const std::string& src, uint64_t key, bool move) {
+    if (!key) return false;
+    uint64_t hash = HashFile(src);
+    int      w, h;
+    if (!hash || !ReadImageSize(src, w, h)) {
+        if (move) { std::error_code ec; fs::remove(src, ec); }
+        return false;
+    }
+
+    ArtEntry e;
+    e.hash = hash; e.w = w; e.h = h;
+    std::string ext = fs::path(src).extension().string();
+    for (auto& c : ext) c = (char)tolower((unsigned char)c);
+    if (ext != ".png") ext = ".jpg";   // WIC sniffs the content; this is only a hint
+    memcpy(e.ext, ext.c_str(), ext.size() + 1);
+
+    std::string dst = PathOf(e);
+    std::error_code ec;
+    fs::create_directories(m_dir, ec);
+    if (fs::exists(dst, ec)) {
+        if (move) fs::remove(src, ec);           // same bytes already stored
+    } else if (move) {
+        fs::rename(src, dst, ec);
+        if (ec) { ec.clear(); fs::copy_file(src, dst, ec); fs::remove(src, ec); }   // other volume
+    } else {
+        fs::copy_file(src, dst, ec);
+    }
+    if (!fs::exists(dst, ec)) return false;
+
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        if (it->second.hash == hash) return true;
+        // Replaced art: drop the old blob once nothing else points at it.
+        uint64_t old = it->second.hash;
+        if (--m_refs[old] <= 0) {
+            m_refs.erase(old);
+            fs::remove(PathOf(it->second), ec);
+        }
+    }
+    m_entries[key] = e;
+    m_refs[hash]++;
+    m_dirty = true;
+    return true;
+}
+
+void ArtStore::Put(uint64_t key, const ArtEntry& e) {
+    if (!key || !e.hash) return;
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        if (it->second.hash == e.hash) return;
+        if (--m_refs[it->second.hash] <= 0) m_refs.erase(it->second.hash);
+    }
+    m_entries[key] = e;
+    m_refs[e.hash]++;
+    m_dirty = true;
+}
+
+bool ArtStore::Has(uint64_t key) const {
+    std::lock_guard<std::mutex> l(m_mutex);
+    return m_entries.count(key) != 0;
+}
+
+bool ArtStore::Find(uint64_t key, ArtEntry& out) const {
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return false;
+    out = it->second;
+    return true;
+}
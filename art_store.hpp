@@ -0,0 +1,65 @@
+// ============================================================================
+// ART_STORE.HPP - Q-SHELL v3.0
+// Content-addressed poster store.
+//
+// Poster files live in img\store\ named by a 64-bit hash of their bytes, so
+// identical art (the same header shipped for two editions, the same image
+// picked twice) is stored once, and display names never reach the file
+// system. A small manifest maps each game's art key -> (hash, size, extension)
+// and is loaded once at startup; after that "does this game have art" and
+// "which file is it" are hash-map lookups with no file system access.
+//
+// Art keys come from LibraryIndex: (platform, appId) for store games, so art
+// survives a reinstall on another drive, else the normalised exe path.
+// ============================================================================
+
+#pragma once
+
+#include "game_finder.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct ArtEntry {
+    uint64_t hash = 0;
+    int      w = 0, h = 0;
+    char     ext[6] = {};   // ".jpg" / ".png"
+};
+
+class ArtStore {
+public:
+    // Loads the manifest. False if there was none (a first run, or an install
+    // that still has legacy img\<name> files to migrate).
+    bool Load(const std::string& manifestPath, const std::string& storeDir);
+    bool Save();   // no-op unless something changed
+
+    // Hashes src and files it under key. With move, src is consumed (renamed
+    // into the store, or deleted if the store already holds those bytes).
+    bool Ingest(const std::string& src, uint64_t key, bool move);
+
+    // Records key -> e without touching files (journal replay).
+    void Put(uint64_t key, const ArtEntry& e);
+
+    bool        Has(uint64_t key) const;
+    bool        Find(uint64_t key, ArtEntry& out) const;
+    std::string PathOf(const ArtEntry& e) const;
+    std::string IncomingPath(uint64_t key, const std::string& ext) const;   // download target
+
+    static std::string KeyString(uint64_t key);          // 16 hex digits, the fetcher's tag
+    static uint64_t    ParseKey(const std::string& s);   // 0 if malformed
+
+    static uint64_t KeyFor(const GameInfo& g);
+    static uint64_t HashFile(const std::string& path);   // 0 if unreadable
+
+private:
+    mutable std::mutex                     m_mutex;
+    std::unordered_map<uint64_t, ArtEntry> m_entries;
+    std::unordered_map<uint64_t, int>      m_refs;      // content hash -> keys using it
+    std::string                            m_manifest, m_dir;
+    bool                                   m_dirty  = false;
+    bool                                   m_loaded = false;   // a manifest exists on disk
+};
+
+ArtStore& Posters();
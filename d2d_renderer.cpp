@@ -10,6 +10,7 @@
 #include <d2d1_1helper.h>
 #include <d2d1effects.h>
 #include <dwrite.h>
+#include <dwrite_1.h>
 #include <wincodec.h>
 
 #include "d2d_renderer.hpp"
@@ -17,16 +18,62 @@
 #include <string>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <type_traits>
+#include <vector>
+
+// The ASCII fast path widens 16 bytes a step; needs 16-bit wchar_t (Windows).
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)) && WCHAR_MAX <= 0xFFFF
+#include <emmintrin.h>
+#define QS_WIDEN_SSE2 1
+#endif
 
-// ─── UTF-8 → UTF-16 helper ────────────────────────────────────────────────────
+// Fading UIs mint a new colour pair every frame; past this many the cache is
+// flushed rather than grown.
+static const size_t GRADIENT_CACHE_MAX = 256;
+
+// Labels, hints and the visible game names fit comfortably; strings that
+// change every frame (clocks, percentages) cycle through the tail.
+static const size_t TEXT_CACHE_MAX = 512;
+
+static const wchar_t* const UI_FONT = L"Segoe UI";   // ClearType-hinted system font
 
-static std::wstring ToWide(const char* s) {
-    if (!s || !s[0]) return L"";
-    int n = MultiByteToWideChar(CP_UTF8, 0, s, -1, nullptr, 0);
-    std::wstring w(n, 0);
-    MultiByteToWideChar(CP_UTF8, 0, s, -1, w.data(), n);
-    if (!w.empty() && w.back() == 0) w.pop_back();
-    return w;
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+// ─── UTF-8 → UTF-16 helper ────────────────────────────────────────────────────
+// Converts n bytes of s into a per-thread scratch buffer that only grows, so
+// the steady state allocates nothing. The result is NUL-terminated and valid
+// until the next call on the same thread. Pure ASCII (nearly every label and
+// path) is widened 16 bytes at a time; anything else goes to
+// MultiByteToWideChar in a single pass, since UTF-16 never needs more units
+// than the UTF-8 has bytes.
+
+static const wchar_t* Widen(const char* s, size_t n)
+{
+    thread_local std::vector<wchar_t> buf(256);
+    if (buf.size() < n + 1) buf.resize(n + 1);
+    wchar_t*             out = buf.data();
+    const unsigned char* p   = (const unsigned char*)s;
+    size_t               i   = 0;
+#ifdef QS_WIDEN_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+        if (_mm_movemask_epi8(v)) break;   // a byte >= 0x80 somewhere in these 16
+        _mm_storeu_si128((__m128i*)(out + i),     _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i*)(out + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#endif
+    for (; i < n && p[i] < 0x80; i++) out[i] = (wchar_t)p[i];
+    if (i < n) {
+        int len = MultiByteToWideChar(CP_UTF8, 0, s, (int)n, out, (int)n);
+        i = len > 0 ? (size_t)len : 0;
+    }
+    out[i] = 0;
+    return out;
 }
 
 // ─── Init ────────────────────────────────────────────────────────────────────
@@ -91,6 +138,9 @@ void D2DRenderer::Shutdown()
 {
     for (auto& [k, tf] : m_tfCache) if (tf) tf->Release();
     m_tfCache.clear();
+    ReleaseGradients();
+    ReleaseTextCache();
+    m_ascii.clear();
 
     if (m_brush) { m_brush->Release(); m_brush = nullptr; }
     if (m_wic)   { m_wic->Release();   m_wic   = nullptr; }
@@ -118,6 +168,7 @@ void D2DRenderer::BeginFrame(D2D1_COLOR_F clearColor)
     m_rt->Clear(clearColor);
     m_drawing = true;
     m_clipDepth = 0;
+    m_stats = {};
 }
 
 void D2DRenderer::EndFrame()
@@ -129,6 +180,7 @@ void D2DRenderer::EndFrame()
     HRESULT hr = m_rt->EndDraw();
     if (hr == D2DERR_RECREATE_TARGET) {
         // Device lost — rebuild on next frame
+        ReleaseGradients();
         m_rt->Release(); m_rt = nullptr;
         m_brush->Release(); m_brush = nullptr;
         D2D1_RENDER_TARGET_PROPERTIES rtp = D2D1::RenderTargetProperties(
@@ -141,6 +193,7 @@ void D2DRenderer::EndFrame()
         if (m_rt) m_rt->CreateSolidColorBrush(D2D1::ColorF(1,1,1,1), &m_brush);
     }
     m_drawing = false;
+    m_lastStats = m_stats;
 }
 
 // ─── Internal brush helper ────────────────────────────────────────────────────
@@ -177,42 +230,78 @@ void D2DRenderer::StrokeRoundRect(float x, float y, float w, float h,
         Brush(c), strokeW);
 }
 
+// ─── Gradients ────────────────────────────────────────────────────────────────
+// A fade scales both stops' alpha by the same factor, so the stops are keyed
+// relative to the more opaque one and the factor goes on the brush as its
+// opacity: a fading panel reuses one collection for its whole animation.
+
+static uint32_t PackColor(D2D1_COLOR_F c, float alphaScale)
+{
+    auto q = [](float v) { return (uint32_t)(std::min(std::max(v, 0.f), 1.f) * 255.f + 0.5f); };
+    return q(c.r) << 24 | q(c.g) << 16 | q(c.b) << 8 | q(c.a * alphaScale);
+}
+
+static D2D1_COLOR_F UnpackColor(uint32_t p)
+{
+    return D2D1::ColorF((p >> 24) / 255.f, ((p >> 16) & 255) / 255.f,
+                        ((p >> 8) & 255) / 255.f, (p & 255) / 255.f);
+}
+
+ID2D1LinearGradientBrush* D2DRenderer::Gradient(D2D1_COLOR_F from, D2D1_COLOR_F to,
+                                                D2D1_POINT_2F p0, D2D1_POINT_2F p1)
+{
+    m_stats.gradientCalls++;
+    float opacity = std::max(from.a, to.a);
+    if (opacity <= 0.f) return nullptr;
+    uint64_t key = (uint64_t)PackColor(from, 1.f / opacity) << 32 | PackColor(to, 1.f / opacity);
+
+    auto it = m_gradCache.find(key);
+    if (it == m_gradCache.end()) {
+        m_stats.gradientMisses++;
+        if (m_gradCache.size() >= GRADIENT_CACHE_MAX) ReleaseGradients();
+        D2D1_GRADIENT_STOP gs[2] = {{0.f, UnpackColor((uint32_t)(key >> 32))},
+                                    {1.f, UnpackColor((uint32_t)key)}};
+        GradientEntry e{};
+        if (FAILED(m_rt->CreateGradientStopCollection(gs, 2, &e.stops))) return nullptr;
+        m_stats.comCreated++;
+        if (FAILED(m_rt->CreateLinearGradientBrush(
+                D2D1::LinearGradientBrushProperties(p0, p1), e.stops, &e.brush))) {
+            e.stops->Release();
+            return nullptr;
+        }
+        m_stats.comCreated++;
+        it = m_gradCache.emplace(key, e).first;
+    }
+    ID2D1LinearGradientBrush* br = it->second.brush;
+    br->SetStartPoint(p0);
+    br->SetEndPoint(p1);
+    br->SetOpacity(opacity);
+    return br;
+}
+
+void D2DRenderer::ReleaseGradients()
+{
+    for (auto& [k, e] : m_gradCache) {
+        if (e.brush) e.brush->Release();
+        if (e.stops) e.stops->Release();
+    }
+    m_gradCache.clear();
+}
+
 void D2DRenderer::FillGradientV(float x, float y, float w, float h,
                                   D2D1_COLOR_F top, D2D1_COLOR_F bot)
 {
     if (!m_rt) return;
-    ID2D1GradientStopCollection* stops = nullptr;
-    D2D1_GRADIENT_STOP gs[2] = {{0.f, top},{1.f, bot}};
-    if (FAILED(m_rt->CreateGradientStopCollection(gs, 2, &stops))) return;
-
-    ID2D1LinearGradientBrush* br = nullptr;
-    m_rt->CreateLinearGradientBrush(
-        D2D1::LinearGradientBrushProperties({x, y}, {x, y+h}),
-        stops, &br);
-    stops->Release();
-    if (br) {
+    if (auto* br = Gradient(top, bot, {x, y}, {x, y+h}))
         m_rt->FillRectangle(D2D1::RectF(x, y, x+w, y+h), br);
-        br->Release();
-    }
 }
 
 void D2DRenderer::FillGradientH(float x, float y, float w, float h,
                                   D2D1_COLOR_F left, D2D1_COLOR_F right)
 {
     if (!m_rt) return;
-    ID2D1GradientStopCollection* stops = nullptr;
-    D2D1_GRADIENT_STOP gs[2] = {{0.f, left},{1.f, right}};
-    if (FAILED(m_rt->CreateGradientStopCollection(gs, 2, &stops))) return;
-
-    ID2D1LinearGradientBrush* br = nullptr;
-    m_rt->CreateLinearGradientBrush(
-        D2D1::LinearGradientBrushProperties({x, y}, {x+w, y}),
-        stops, &br);
-    stops->Release();
-    if (br) {
+    if (auto* br = Gradient(left, right, {x, y}, {x+w, y}))
         m_rt->FillRectangle(D2D1::RectF(x, y, x+w, y+h), br);
-        br->Release();
-    }
 }
 
 // ─── Blur / frosted glass ─────────────────────────────────────────────────────
@@ -272,7 +361,7 @@ IDWriteTextFormat* D2DRenderer::TextFormat(float size, DWRITE_FONT_WEIGHT weight
 
     IDWriteTextFormat* tf = nullptr;
     HRESULT hr = m_dw->CreateTextFormat(
-        L"Segoe UI",           // Segoe UI: Windows system font, ClearType-hinted
+        UI_FONT,
         nullptr,
         weight,
         DWRITE_FONT_STYLE_NORMAL,
@@ -296,47 +385,220 @@ IDWriteTextLayout* D2DRenderer::MakeLayout(const wchar_t* text, float size,
     auto* tf = TextFormat(size, weight);
     if (!tf || !text) return nullptr;
     IDWriteTextLayout* layout = nullptr;
-    m_dw->CreateTextLayout(text, (UINT32)wcslen(text), tf, maxW, maxH, &layout);
+    if (SUCCEEDED(m_dw->CreateTextLayout(text, (UINT32)wcslen(text), tf, maxW, maxH, &layout)))
+        m_stats.comCreated++;
     return layout;
 }
 
+// ─── Text layout cache ────────────────────────────────────────────────────────
+
+static uint64_t HashBytes(const char* p, size_t n, uint64_t seed)
+{
+    uint64_t h = 1469598103934665603ull ^ seed;   // FNV-1a
+    for (size_t i = 0; i < n; i++) { h ^= (unsigned char)p[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+const D2DRenderer::CachedText* D2DRenderer::CachedLayout(const char* bytes, size_t n, bool wide,
+                                                         float size, DWRITE_FONT_WEIGHT weight)
+{
+    TextKey key{HashBytes(bytes, n, wide ? 0x57 : 0x41), size, (int)weight};
+    auto it = m_textCache.find(key);
+    if (it != m_textCache.end()) {
+        auto e = it->second;
+        if (e->bytes.size() == n && memcmp(e->bytes.data(), bytes, n) == 0) {
+            m_textLru.splice(m_textLru.begin(), m_textLru, e);
+            m_stats.textHits++;
+            return &*e;
+        }
+        e->layout->Release();   // collision: the newer string takes the slot
+        m_textLru.erase(e);
+        m_textCache.erase(it);
+    }
+    m_stats.textMisses++;
+
+    // The W calls pass their NUL-terminated text straight through.
+    const wchar_t*     w      = wide ? (const wchar_t*)bytes : Widen(bytes, n);
+    IDWriteTextLayout* layout = MakeLayout(w, size, weight, 4096.f, size * 2.f);
+    if (!layout) return nullptr;
+    DWRITE_TEXT_METRICS m{};
+    layout->GetMetrics(&m);
+
+    if (m_textLru.size() >= TEXT_CACHE_MAX) {
+        auto& old = m_textLru.back();
+        old.layout->Release();
+        m_textCache.erase(old.key);
+        m_textLru.pop_back();
+    }
+    m_textLru.push_front({key, std::string(bytes, n), layout, m.widthIncludingTrailingWhitespace});
+    m_textCache[key] = m_textLru.begin();
+    return &m_textLru.front();
+}
+
+void D2DRenderer::ReleaseTextCache()
+{
+    for (auto& e : m_textLru) e.layout->Release();
+    m_textLru.clear();
+    m_textCache.clear();
+}
+
 // ─── Text drawing ─────────────────────────────────────────────────────────────
+// Drawing and measuring share the cache: centring a label measures it and
+// then draws it, and both reuse one layout from frame to frame.
 
 void D2DRenderer::DrawTextW(const wchar_t* text, float x, float y, float size,
                              D2D1_COLOR_F c, DWRITE_FONT_WEIGHT weight)
 {
-    if (!m_rt || !text || !text[0]) return;
-    auto* tf = TextFormat(size, weight);
-    if (!tf) return;
-    m_rt->DrawText(text, (UINT32)wcslen(text), tf,
-                    D2D1::RectF(x, y, x + 4096.f, y + size * 2.f),
-                    Brush(c),
-                    D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT,
-                    DWRITE_MEASURING_MODE_NATURAL);
+    if (!m_rt || !m_dw || !text || !text[0]) return;
+    auto* t = CachedLayout((const char*)text, wcslen(text) * sizeof(wchar_t), true, size, weight);
+    if (!t) return;
+    m_rt->DrawTextLayout(D2D1::Point2F(x, y), t->layout, Brush(c),
+                         D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
 }
 
 void D2DRenderer::DrawTextA(const char* text, float x, float y, float size,
                              D2D1_COLOR_F c, DWRITE_FONT_WEIGHT weight)
 {
-    DrawTextW(ToWide(text).c_str(), x, y, size, c, weight);
+    if (!m_rt || !m_dw || !text || !text[0]) return;
+    auto* t = CachedLayout(text, strlen(text), false, size, weight);
+    if (!t) return;
+    m_rt->DrawTextLayout(D2D1::Point2F(x, y), t->layout, Brush(c),
+                         D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
 }
 
 float D2DRenderer::MeasureTextW(const wchar_t* text, float size,
                                  DWRITE_FONT_WEIGHT weight)
 {
     if (!m_dw || !text || !text[0]) return 0.f;
-    auto* layout = MakeLayout(text, size, weight);
-    if (!layout) return 0.f;
-    DWRITE_TEXT_METRICS m{};
-    layout->GetMetrics(&m);
-    layout->Release();
-    return m.widthIncludingTrailingWhitespace;
+    float w = MeasureAscii(text, size, weight);
+    if (w >= 0.f) return w;
+    auto* t = CachedLayout((const char*)text, wcslen(text) * sizeof(wchar_t), true, size, weight);
+    return t ? t->width : 0.f;
 }
 
 float D2DRenderer::MeasureTextA(const char* text, float size,
                                  DWRITE_FONT_WEIGHT weight)
 {
-    return MeasureTextW(ToWide(text).c_str(), size, weight);
+    if (!m_dw || !text || !text[0]) return 0.f;
+    float w = MeasureAscii(text, size, weight);
+    if (w >= 0.f) return w;
+    auto* t = CachedLayout(text, strlen(text), false, size, weight);
+    return t ? t->width : 0.f;
+}
+
+// ─── ASCII advance tables ─────────────────────────────────────────────────────
+// Natural-mode layout of a printable ASCII run in one font is the sum of the
+// glyph advances plus the pair kerning, scaled by size / units-per-em: no
+// shaping, no fallback, no hinting. The table is built from the font face the
+// text format resolves to and checked once against a real layout of a few
+// kerning-heavy strings; if DirectWrite applies anything the table doesn't
+// know about (contextual forms, a different font), it is not used.
+
+template <class Ch>
+float D2DRenderer::MeasureAscii(const Ch* text, float size, DWRITE_FONT_WEIGHT weight)
+{
+    const AsciiMetrics* m = Ascii(weight);
+    if (!m || !m->ok) return -1.f;
+    int64_t units = 0;
+    int     prev  = -1;
+    for (const Ch* p = text; *p; p++) {
+        unsigned c = (unsigned)(std::make_unsigned_t<Ch>)*p - ASCII_FIRST;
+        if (c >= (unsigned)ASCII_COUNT) return -1.f;
+        units += m->advance[c];
+        if (prev >= 0) units += m->kern[prev][c];
+        prev = (int)c;
+    }
+    m_stats.textTable++;
+    return (float)units * size / m->unitsPerEm;
+}
+
+const D2DRenderer::AsciiMetrics* D2DRenderer::Ascii(DWRITE_FONT_WEIGHT weight)
+{
+    auto it = m_ascii.find((int)weight);
+    if (it != m_ascii.end()) return it->second.get();
+    auto  table = std::make_unique<AsciiMetrics>();
+    auto& m     = *table;
+    m_ascii[(int)weight] = std::move(table);   // built once, usable or not
+    if (!m_dw) return &m;
+
+    IDWriteFontCollection* coll   = nullptr;
+    IDWriteFontFamily*     family = nullptr;
+    IDWriteFont*           font   = nullptr;
+    IDWriteFontFace*       face   = nullptr;
+    UINT32 index  = 0;
+    BOOL   exists = FALSE;
+    if (SUCCEEDED(m_dw->GetSystemFontCollection(&coll)) &&
+        SUCCEEDED(coll->FindFamilyName(UI_FONT, &index, &exists)) && exists &&
+        SUCCEEDED(coll->GetFontFamily(index, &family)) &&
+        SUCCEEDED(family->GetFirstMatchingFont(weight, DWRITE_FONT_STRETCH_NORMAL,
+                                               DWRITE_FONT_STYLE_NORMAL, &font)) &&
+        SUCCEEDED(font->CreateFontFace(&face))) {
+        UINT32 cps[ASCII_COUNT];
+        UINT16 glyphs[ASCII_COUNT];
+        DWRITE_GLYPH_METRICS gm[ASCII_COUNT];
+        for (int i = 0; i < ASCII_COUNT; i++) cps[i] = (UINT32)(ASCII_FIRST + i);
+        DWRITE_FONT_METRICS fm{};
+        face->GetMetrics(&fm);
+        bool ok = fm.designUnitsPerEm &&
+                  SUCCEEDED(face->GetGlyphIndices(cps, ASCII_COUNT, glyphs)) &&
+                  std::find(glyphs, glyphs + ASCII_COUNT, 0) == glyphs + ASCII_COUNT &&   // no missing glyphs
+                  SUCCEEDED(face->GetDesignGlyphMetrics(glyphs, ASCII_COUNT, gm, FALSE));
+        if (ok) {
+            m.unitsPerEm = (float)fm.designUnitsPerEm;
+            for (int i = 0; i < ASCII_COUNT; i++) m.advance[i] = (int32_t)gm[i].advanceWidth;
+            memset(m.kern, 0, sizeof(m.kern));
+
+            // Kerning pairs: the face reports one adjustment per adjacent pair,
+            // so "L R0 L R1 L R2 ..." yields [L][Rk] at the even positions.
+            IDWriteFontFace1* face1 = nullptr;
+            if (SUCCEEDED(face->QueryInterface(__uuidof(IDWriteFontFace1), (void**)&face1))) {
+                if (face1->HasKerningPairs()) {
+                    UINT16 run[2 * ASCII_COUNT];
+                    INT32  adj[2 * ASCII_COUNT];
+                    for (int l = 0; l < ASCII_COUNT; l++) {
+                        for (int r = 0; r < ASCII_COUNT; r++) { run[2 * r] = glyphs[l]; run[2 * r + 1] = glyphs[r]; }
+                        if (FAILED(face1->GetKerningPairAdjustments(2 * ASCII_COUNT, run, adj))) { ok = false; break; }
+                        for (int r = 0; r < ASCII_COUNT; r++) m.kern[l][r] = (int16_t)adj[2 * r];
+                    }
+                }
+                face1->Release();
+            }
+        }
+        m.ok = ok;
+    }
+    if (face)   face->Release();
+    if (font)   font->Release();
+    if (family) family->Release();
+    if (coll)   coll->Release();
+
+    // Check against DirectWrite itself before trusting the table.
+    if (m.ok) {
+        static const wchar_t* const PROBES[] = {
+            L"AVATAR WAVE To Ty Yo Vo LT P. F, r. y, \"quoted\" 'single'",
+            L"The quick brown fox jumps over the lazy dog 0123456789",
+            L"[A] LAUNCH  [B] BACK  [Y] OPTIONS  {~|}^_`@#$%&*()+-=<>?/;:",
+            // Default ligatures (fi fl ff ffi ffl) shape narrower than the pairs.
+            L"Office fluffy affine waffle fjord baffled Firefly ffi ffl fi fl ff",
+        };
+        const float probeSize = 32.f;
+        for (const wchar_t* probe : PROBES) {
+            IDWriteTextLayout* layout = MakeLayout(probe, probeSize, weight);
+            if (!layout) { m.ok = false; break; }
+            DWRITE_TEXT_METRICS tm{};
+            layout->GetMetrics(&tm);
+            layout->Release();
+            float mine = MeasureAscii(probe, probeSize, weight);
+            if (std::fabs(mine - tm.widthIncludingTrailingWhitespace) > 0.05f) {
+                m.ok = false;
+                char buf[160];
+                snprintf(buf, sizeof(buf), "[render] ASCII width table off by %.2f at weight %d; measuring with layouts",
+                         mine - tm.widthIncludingTrailingWhitespace, (int)weight);
+                DebugLog(buf);
+                break;
+            }
+        }
+    }
+    return &m;
 }
 
 // ─── Bitmap loading (WIC) ─────────────────────────────────────────────────────
@@ -382,7 +644,7 @@ D2DBitmap D2DRenderer::LoadBitmap(const wchar_t* path)
 
 D2DBitmap D2DRenderer::LoadBitmapA(const char* path)
 {
-    return LoadBitmap(ToWide(path).c_str());
+    return path ? LoadBitmap(Widen(path, strlen(path))) : D2DBitmap{};
 }
 
 void D2DRenderer::UnloadBitmap(D2DBitmap& bmp)
@@ -18,6 +18,9 @@
 #include <d2d1helper.h>
 #include <dwrite.h>
 #include <wincodec.h>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -37,6 +40,19 @@ struct D2DBitmap {
     bool Valid() const { return bmp != nullptr; }
 };
 
+// ─── D2DFrameStats ───────────────────────────────────────────────────────────
+// Per-frame resource churn, reset by BeginFrame. comCreated counts every D2D /
+// DirectWrite object created while drawing; a steady frame should create none.
+
+struct D2DFrameStats {
+    uint32_t comCreated     = 0;
+    uint32_t gradientCalls  = 0;   // FillGradientV / H
+    uint32_t gradientMisses = 0;   // calls that had to create a stop collection
+    uint32_t textHits       = 0;   // draws / measures served by a cached layout
+    uint32_t textMisses     = 0;   // ... that had to shape the string
+    uint32_t textTable      = 0;   // ASCII measures summed from the advance table
+};
+
 // ─── D2DRenderer ─────────────────────────────────────────────────────────────
 
 class D2DRenderer {
@@ -118,6 +134,9 @@ public:
     int   ScreenHeight()  const { return m_h; }
     HWND  Hwnd        ()  const { return m_hwnd; }
 
+    // Counters for the last finished frame
+    const D2DFrameStats& LastFrameStats() const { return m_lastStats; }
+
     // Raw access (plugin_manager.cpp uses this directly for the skin picker)
     ID2D1HwndRenderTarget* RT()  { return m_rt;  }
     IDWriteFactory*         DW()  { return m_dw;  }
@@ -138,6 +157,12 @@ private:
     // Get or create a solid brush for the given colour
     ID2D1SolidColorBrush* Brush(D2D1_COLOR_F c);
 
+    // Get or create the gradient brush for a (from, to) colour pair, pointed
+    // from p0 to p1. nullptr if the gradient is fully transparent.
+    ID2D1LinearGradientBrush* Gradient(D2D1_COLOR_F from, D2D1_COLOR_F to,
+                                       D2D1_POINT_2F p0, D2D1_POINT_2F p1);
+    void ReleaseGradients();
+
     // Get or create an IDWriteTextFormat for a given (size, weight) pair
     IDWriteTextFormat* TextFormat(float size, DWRITE_FONT_WEIGHT weight);
 
@@ -146,6 +171,40 @@ private:
                                   DWRITE_FONT_WEIGHT weight,
                                   float maxW = 4096.f, float maxH = 256.f);
 
+    // Cached layout + width for a string, keyed by a hash of its bytes as
+    // given (UTF-8 for the A calls, UTF-16 for the W calls), so a hit never
+    // converts. nullptr if the layout can't be built.
+    struct TextKey {
+        uint64_t hash; float size; int weight;
+        bool operator==(const TextKey& o) const { return hash==o.hash&&size==o.size&&weight==o.weight; }
+    };
+    struct TextKeyHash { size_t operator()(const TextKey& k) const { return (size_t)(k.hash ^ (uint64_t)std::hash<float>()(k.size) ^ ((uint64_t)k.weight<<48)); } };
+    struct CachedText {
+        TextKey            key;
+        std::string        bytes;     // the hashed bytes; a 64-bit collision is still a miss
+        IDWriteTextLayout* layout;
+        float              width;     // widthIncludingTrailingWhitespace
+    };
+    const CachedText* CachedLayout(const char* bytes, size_t n, bool wide,
+                                   float size, DWRITE_FONT_WEIGHT weight);
+    void ReleaseTextCache();
+
+    // Printable-ASCII advances and kerning pairs for the UI font at one
+    // weight, in font design units, so one table serves every size.
+    // ok is false when the table didn't reproduce DirectWrite's own widths
+    // (or the font couldn't be read); measuring then takes the layout path.
+    static const int ASCII_FIRST = 0x20, ASCII_COUNT = 0x7F - 0x20;
+    struct AsciiMetrics {
+        bool    ok         = false;
+        float   unitsPerEm = 1.f;
+        int32_t advance[ASCII_COUNT];
+        int16_t kern[ASCII_COUNT][ASCII_COUNT];   // [left][right]
+    };
+    const AsciiMetrics* Ascii(DWRITE_FONT_WEIGHT weight);
+    // Width from the table, or -1 if text has anything outside 0x20-0x7E.
+    template <class Ch>
+    float MeasureAscii(const Ch* text, float size, DWRITE_FONT_WEIGHT weight);
+
     HWND                        m_hwnd    = nullptr;
     ID2D1Factory1*              m_fac     = nullptr;
     ID2D1HwndRenderTarget*      m_rt      = nullptr;
@@ -161,6 +220,22 @@ private:
     struct TFKey { float size; int weight; bool operator==(const TFKey& o) const { return size==o.size&&weight==o.weight; } };
     struct TFHash { size_t operator()(const TFKey& k) const { return std::hash<float>()(k.size) ^ (std::hash<int>()(k.weight)<<16); } };
     std::unordered_map<TFKey, IDWriteTextFormat*, TFHash> m_tfCache;
+
+    // Gradient stop collections keyed by their two colours (8 bits a channel,
+    // alpha relative to the more opaque stop), each with one brush whose
+    // points and opacity are set per call. Device resources: dropped with
+    // the render target.
+    struct GradientEntry { ID2D1GradientStopCollection* stops; ID2D1LinearGradientBrush* brush; };
+    std::unordered_map<uint64_t, GradientEntry> m_gradCache;
+
+    // Text layouts, most recently used first. Layouts are device-independent,
+    // so this survives a lost render target.
+    std::list<CachedText>                                                m_textLru;
+    std::unordered_map<TextKey, std::list<CachedText>::iterator, TextKeyHash> m_textCache;
+
+    std::unordered_map<int, std::unique_ptr<AsciiMetrics>> m_ascii;   // weight -> table
+
+    D2DFrameStats m_stats, m_lastStats;
 };
 
 // Global shorthand — same pattern as PM()
@@ -0,0 +1,315 @@
+// ============================================================================
+// DIR_SIZE_INDEX.CPP - Q-SHELL v3.0
+//
+// sizes.txt:
+//   QSIZES1
+//   T|<root>|<bytes>
+//   D|<dir>|<mtime>|<file bytes>|<subdir>/<subdir>/...
+// ============================================================================
+
+#include "dir_size_index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+static const char SEP = (char)fs::path::preferred_separator;
+
+DirSizeIndex& Sizes() {
+    static DirSizeIndex index;
+    return index;
+}
+
+// ─── Paths ───────────────────────────────────────────────────────────────────
+
+std::string DirSizeIndex::Key(const std::string& path) {
+    std::string k = path;
+#ifdef _WIN32
+    for (char& c : k) {
+        if (c == '/') c = '\\';
+        else if (c >= 'A' && c <= 'Z') c = (char)(c + 32);
+    }
+#endif
+    while (k.size() > 1 && k.back() == SEP && !(k.size() == 3 && k[1] == ':')) k.pop_back();
+    return k;
+}
+
+std::string DirSizeIndex::InstallRoot(const std::string& exePath) {
+    fs::path exe(exePath);
+    if (exePath.find("://") != std::string::npos || !exe.is_absolute() || !exe.has_parent_path()) return "";
+    std::string dir = Key(exe.parent_path().string());
+
+    // Steam: everything under steamapps\common\<installdir> is the game.
+    std::string common = std::string(1, SEP) + "steamapps" + SEP + "common" + SEP;
+    std::string folded = dir;
+    for (char& c : folded) if (c >= 'A' && c <= 'Z') c = (char)(c + 32);
+    size_t at = folded.find(common);
+    if (at != std::string::npos) {
+        size_t end = dir.find(SEP, at + common.size());
+        return end == std::string::npos ? dir : dir.substr(0, end);
+    }
+
+    // Elsewhere the exe's folder, minus the usual binary subfolders.
+    static const char* const HELPERS[] = { "bin", "binaries", "win64", "win32", "x64", "x86" };
+    for (;;) {
+        size_t cut = dir.find_last_of(SEP);
+        if (cut == std::string::npos || cut <= 3) break;   // never climb to a drive root
+        std::string leaf = folded.substr(cut + 1);
+        if (std::none_of(std::begin(HELPERS), std::end(HELPERS), [&](const char* h) { return leaf == h; })) break;
+        dir.resize(cut);
+        folded.resize(cut);
+    }
+    return dir;
+}
+
+// ─── Requests ────────────────────────────────────────────────────────────────
+
+void DirSizeIndex::Request(const std::string& root, bool full) {
+    if (root.empty()) return;
+    std::string k = Key(root);
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_queued.find(k);
+    if (it != m_queued.end()) { it->second = it->second || full; return; }
+    m_queued[k] = full;
+    m_queue.push_back(std::move(k));
+    m_cv.notify_one();
+}
+
+bool DirSizeIndex::Find(const std::string& root, uint64_t& bytes) const {
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_totals.find(Key(root));
+    if (it == m_totals.end()) return false;
+    bytes = it->second;
+    return true;
+}
+
+void DirSizeIndex::DispatchCompletions() {
+    std::vector<SizeResult> done;
+    {
+        std::lock_guard<std::mutex> l(m_doneMutex);
+        if (m_done.empty()) return;
+        done.swap(m_done);
+    }
+    if (m_listener) for (auto& r : done) m_listener(r);
+}
+
+// ─── Walk ────────────────────────────────────────────────────────────────────
+
+void DirSizeIndex::Forget(const std::string& dir) {
+    std::vector<std::string> todo{ dir };
+    while (!todo.empty()) {
+        std::string d = std::move(todo.back());
+        todo.pop_back();
+        auto it = m_dirs.find(d);
+        if (it == m_dirs.end()) continue;
+        for (auto& s : it->second.subdirs) todo.push_back(d + SEP + s);
+        m_dirs.erase(it);
+        m_dirty = true;
+    }
+}
+
+bool DirSizeIndex::Walk(const std::string& root, bool full, uint64_t& total, WalkStats& st) {
+    total = 0;
+    std::vector<std::string> todo{ root };
+    while (!todo.empty()) {
+        if (m_stop) return false;
+        std::string dir = std::move(todo.back());
+        todo.pop_back();
+
+        std::error_code ec;
+        auto mt = fs::last_write_time(dir, ec);
+        if (ec) {
+            if (dir == root) { Forget(root); return false; }   // uninstalled, or the drive is gone
+            Forget(dir);
+            continue;
+        }
+        long long mtime = (long long)mt.time_since_epoch().count();
+        st.dirs++;
+
+        auto it = m_dirs.find(dir);
+        if (!full && it != m_dirs.end() && it->second.mtime == mtime) {
+            st.cached++;
+            total += it->second.files;
+            for (auto& s : it->second.subdirs) todo.push_back(dir + SEP + s);
+            continue;
+        }
+
+        // Links and junctions are skipped: what they point at is counted
+        // where it lives, and a loop can't trap the walk.
+        Dir d;
+        d.mtime = mtime;
+        for (fs::directory_iterator e(dir, fs::directory_options::skip_permission_denied, ec), end;
+             !ec && e != end; e.increment(ec)) {
+            std::error_code sec;
+            fs::file_status s = e->symlink_status(sec);
+            if (sec) continue;
+            if (fs::is_directory(s)) {
+                d.subdirs.push_back(Key(e->path().filename().string()));
+            } else if (fs::is_regular_file(s)) {
+                uint64_t n = e->file_size(sec);
+                if (!sec) { d.files += n; st.files++; }
+            }
+        }
+        st.listed++;
+        std::sort(d.subdirs.begin(), d.subdirs.end());
+        if (it != m_dirs.end())
+            for (auto& old : it->second.subdirs)
+                if (!std::binary_search(d.subdirs.begin(), d.subdirs.end(), old)) Forget(dir + SEP + old);
+
+        total += d.files;
+        for (auto& s : d.subdirs) todo.push_back(dir + SEP + s);
+        m_dirs[dir] = std::move(d);
+        m_dirty = true;
+    }
+    st.bytes += total;
+    return true;
+}
+
+void DirSizeIndex::Run() {
+#ifdef _WIN32
+    // Lowers CPU, I/O and memory priority together; a game being launched
+    // never queues behind the size walk.
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+    LoadDirs();
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> l(m_mutex);
+            m_cv.wait(l, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) break;
+        }
+        WalkStats st;
+        int  roots = 0;
+        auto t0    = std::chrono::steady_clock::now();
+        for (;;) {
+            std::string root;
+            bool        full;
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+                if (m_stop || m_queue.empty()) break;
+                root = std::move(m_queue.front());
+                m_queue.pop_front();
+                full = m_queued[root];
+                m_queued.erase(root);
+            }
+            uint64_t total;
+            if (!Walk(root, full, total, st)) continue;
+            roots++;
+            bool changed;
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+                auto it = m_totals.find(root);
+                changed = it == m_totals.end() || it->second != total;
+                m_totals[root] = total;
+            }
+            if (changed) {
+                std::lock_guard<std::mutex> l(m_doneMutex);
+                m_done.push_back({ root, total });
+            }
+        }
+        if (!roots) continue;
+        long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        char buf[256];
+        snprintf(buf, sizeof(buf),
+                 "[sizes] %d folders, %.1f GB: %llu dirs (%.1f%% cached), %llu listed, %llu files in %lld ms (%.0f dirs/s)",
+                 roots, st.bytes / 1073741824.0, (unsigned long long)st.dirs,
+                 st.dirs ? 100.0 * st.cached / st.dirs : 0.0, (unsigned long long)st.listed,
+                 (unsigned long long)st.files, ms, st.dirs * 1000.0 / std::max(1LL, ms));
+        DebugLog(buf);
+        if (m_dirty) Save();
+    }
+    if (m_dirty) Save();
+}
+
+// ─── Persistence ─────────────────────────────────────────────────────────────
+
+static std::vector<std::string> SplitBars(const std::string& line) {
+    std::vector<std::string> p;
+    std::stringstream ss(line);
+    for (std::string t; std::getline(ss, t, '|');) p.push_back(t);
+    if (!line.empty() && line.back() == '|') p.push_back("");
+    return p;
+}
+
+void DirSizeIndex::Load(const std::string& path) {
+    if (m_thread.joinable()) return;
+    m_path = path;
+    {
+        // Totals come first in the file; the directory part is the thread's.
+        std::ifstream f(path);
+        std::string line;
+        if (std::getline(f, line) && line == "QSIZES1") {
+            std::lock_guard<std::mutex> l(m_mutex);
+            while (std::getline(f, line) && line.compare(0, 2, "T|") == 0) {
+                auto p = SplitBars(line);
+                if (p.size() == 3) try { m_totals[p[1]] = std::stoull(p[2]); } catch (...) {}
+            }
+        }
+    }
+    m_stop   = false;
+    m_thread = std::thread(&DirSizeIndex::Run, this);
+}
+
+void DirSizeIndex::LoadDirs() {
+    std::ifstream f(m_path);
+    std::string line;
+    if (!std::getline(f, line) || line != "QSIZES1") return;
+    while (std::getline(f, line)) {
+        if (line.compare(0, 2, "D|") != 0) continue;
+        auto p = SplitBars(line);
+        if (p.size() != 5) continue;
+        Dir d;
+        try {
+            d.mtime = std::stoll(p[2]);
+            d.files = std::stoull(p[3]);
+        } catch (...) { continue; }   // one bad line loses one directory
+        std::stringstream ss(p[4]);
+        for (std::string s; std::getline(ss, s, '/');) if (!s.empty()) d.subdirs.push_back(s);
+        m_dirs[p[1]] = std::move(d);
+    }
+}
+
+void DirSizeIndex::Save() {
+    m_dirty = false;
+    if (m_path.empty()) return;
+    std::string tmp = m_path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        f << "QSIZES1\n";
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            for (auto& [root, bytes] : m_totals) f << "T|" << root << "|" << bytes << "\n";
+        }
+        for (auto& [dir, d] : m_dirs) {
+            f << "D|" << dir << "|" << d.mtime << "|" << d.files << "|";
+            for (size_t i = 0; i < d.subdirs.size(); i++) f << (i ? "/" : "") << d.subdirs[i];
+            f << "\n";
+        }
+        if (!f) return;
+    }
+    std::error_code ec;
+    fs::rename(tmp, m_path, ec);
+    if (ec) fs::remove(tmp, ec);
+}
+
+void DirSizeIndex::Stop() {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
@@ -0,0 +1,112 @@
+// ============================================================================
+// DIR_SIZE_INDEX.HPP - Q-SHELL v3.0
+// Installed size per library entry, from a cached directory size index.
+//
+// One background thread (background I/O priority on Windows) walks install
+// folders and remembers, for every directory it has listed, the directory's
+// mtime, the bytes of the files directly in it and the names of its
+// subdirectories. A directory's mtime changes when an entry in it is added,
+// removed or renamed, so a later walk does not list a directory whose mtime
+// still matches: its cached file bytes are used and only its subdirectories
+// are checked, one stat each. Unchanged trees therefore cost one stat per
+// folder instead of a listing of every file.
+//
+// A patch that rewrites files in place leaves directory mtimes alone; the
+// owner passes full = true when a store reports the game updated, which
+// lists the whole tree again.
+//
+// profile\sizes.txt holds the per-root totals first, so Load() can hand
+// them to the first frame, then the per-directory cache, which the thread
+// reads before its first walk. Like ArtFetcher, finished walks are queued
+// and handed to the listener from DispatchCompletions() on the UI thread.
+// ============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct SizeResult {
+    std::string root;        // Key() form
+    uint64_t    bytes = 0;
+};
+
+class DirSizeIndex {
+public:
+    using Listener = std::function<void(const SizeResult&)>;
+
+    DirSizeIndex() = default;
+    ~DirSizeIndex() { Stop(); }
+    DirSizeIndex(const DirSizeIndex&)            = delete;
+    DirSizeIndex& operator=(const DirSizeIndex&) = delete;
+
+    // Reads the cached totals and starts the walker thread. A missing file
+    // is an empty cache.
+    void Load(const std::string& path);
+
+    // Queues a walk of root. Repeated requests for a queued root fold into
+    // one; full ignores the directory cache for this walk.
+    void Request(const std::string& root, bool full = false);
+
+    bool Find(const std::string& root, uint64_t& bytes) const;
+
+    // UI thread: delivers totals that are new or changed.
+    void SetListener(Listener l) { m_listener = std::move(l); }
+    void DispatchCompletions();
+
+    // Abandons a walk in progress, saves the cache and joins the thread.
+    void Stop();
+
+    // The folder to measure for a game's exe: the Steam install folder when
+    // the exe is under steamapps\common, otherwise the exe's folder with
+    // trailing bin / x64-style folders stripped. "" for anything that is
+    // not an absolute path (URLs, launcher protocols).
+    static std::string InstallRoot(const std::string& exePath);
+
+    // Cache key for a path: case-folded on Windows, no trailing separator.
+    static std::string Key(const std::string& path);
+
+private:
+    struct Dir {
+        long long                mtime = 0;
+        uint64_t                 files = 0;   // bytes directly in this directory
+        std::vector<std::string> subdirs;     // sorted names
+    };
+    struct WalkStats {
+        uint64_t dirs = 0, cached = 0, listed = 0, files = 0, bytes = 0;
+    };
+
+    void Run();
+    void LoadDirs();
+    bool Walk(const std::string& root, bool full, uint64_t& total, WalkStats& st);
+    void Forget(const std::string& dir);   // a directory and everything cached under it
+    void Save();
+
+    std::string                  m_path;
+    std::thread                  m_thread;
+    std::atomic<bool>            m_stop{ false };
+
+    // Walker thread only.
+    std::unordered_map<std::string, Dir> m_dirs;
+    bool                                 m_dirty = false;
+
+    mutable std::mutex                        m_mutex;
+    std::condition_variable                   m_cv;
+    std::deque<std::string>                   m_queue;
+    std::unordered_map<std::string, bool>     m_queued;   // root -> full
+    std::unordered_map<std::string, uint64_t> m_totals;   // root -> bytes
+
+    std::mutex              m_doneMutex;
+    std::vector<SizeResult> m_done;
+    Listener                m_listener;
+};
+
+DirSizeIndex& Sizes();
@@ -0,0 +1,260 @@
+// ============================================================================
+// EXE_FINGERPRINT.CPP - Q-SHELL v3.0
+//
+// fingerprints.txt:
+//   QPRINT1
+//   F|<exe key hex>|<size>|<mtime>|<hash hex>
+// ============================================================================
+
+#include "exe_fingerprint.hpp"
+#include "library_index.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+static const size_t   SAMPLE  = 64 * 1024;   // bytes hashed at each end
+static const unsigned THREADS = 2;
+
+FingerprintIndex& Fingerprints() {
+    static FingerprintIndex index;
+    return index;
+}
+
+// ─── XXH64 ───────────────────────────────────────────────────────────────────
+
+static const uint64_t P1 = 0x9E3779B185EBCA87ull;
+static const uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+static const uint64_t P3 = 0x165667B19E3779F9ull;
+static const uint64_t P4 = 0x85EBCA77C2B2AE63ull;
+static const uint64_t P5 = 0x27D4EB2F165667C5ull;
+
+static inline uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+static inline uint64_t Read64(const unsigned char* p) { uint64_t v; memcpy(&v, p, 8); return v; }   // little-endian hosts
+static inline uint32_t Read32(const unsigned char* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+static inline uint64_t Round(uint64_t acc, uint64_t in) { return Rotl(acc + in * P2, 31) * P1; }
+static inline uint64_t Merge(uint64_t acc, uint64_t v)  { return (acc ^ Round(0, v)) * P1 + P4; }
+
+uint64_t XXH64(const void* data, size_t len, uint64_t seed) {
+    const unsigned char* p   = (const unsigned char*)data;
+    const unsigned char* end = p + len;
+    uint64_t h;
+    if (len >= 32) {
+        // Four independent lanes: the multiply chains overlap in the pipeline.
+        uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+        for (const unsigned char* limit = end - 32; p <= limit; p += 32) {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+        }
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = Merge(h, v1);
+        h = Merge(h, v2);
+        h = Merge(h, v3);
+        h = Merge(h, v4);
+    } else {
+        h = seed + P5;
+    }
+    h += (uint64_t)len;
+    for (; p + 8 <= end; p += 8) h = Rotl(h ^ Round(0, Read64(p)), 27) * P1 + P4;
+    if (p + 4 <= end) { h = Rotl(h ^ (Read32(p) * P1), 23) * P2 + P3; p += 4; }
+    for (; p < end; p++) h = Rotl(h ^ (*p * P5), 11) * P1;
+    h ^= h >> 33; h *= P2;
+    h ^= h >> 29; h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+bool FingerprintIndex::Compute(const std::string& path, ExeFingerprint& out) {
+    std::error_code ec;
+    uint64_t size = fs::file_size(path, ec);
+    if (ec || size == 0) return false;
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+
+    thread_local std::vector<char> buf(2 * SAMPLE);
+    size_t head = (size_t)std::min<uint64_t>(size, SAMPLE);
+    size_t tail = (size_t)std::min<uint64_t>(size - head, SAMPLE);
+    f.read(buf.data(), head);
+    if (tail) {
+        f.seekg((std::streamoff)(size - tail));
+        f.read(buf.data() + head, tail);
+    }
+    if (!f) return false;
+    out.size = size;
+    out.hash = XXH64(buf.data(), head + tail, size);
+    return true;
+}
+
+// ─── Requests ────────────────────────────────────────────────────────────────
+
+void FingerprintIndex::Request(const std::string& exePath, uint64_t tag) {
+    if (exePath.empty() || exePath.find("://") != std::string::npos) return;
+    std::lock_guard<std::mutex> l(m_mutex);
+    if (m_threads.empty()) return;
+    m_queue.push_back({ exePath, tag });
+    m_cv.notify_one();
+}
+
+bool FingerprintIndex::Find(const std::string& exePath, ExeFingerprint& out) const {
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_cache.find(LibraryIndex::ExeKey(exePath));
+    if (it == m_cache.end()) return false;
+    out = it->second.print;
+    return true;
+}
+
+void FingerprintIndex::DispatchCompletions() {
+    std::vector<FingerprintResult> done;
+    {
+        std::lock_guard<std::mutex> l(m_doneMutex);
+        if (m_done.empty()) return;
+        done.swap(m_done);
+    }
+    if (m_listener) m_listener(done);
+}
+
+void FingerprintIndex::Process(const Job& j) {
+    uint64_t key = LibraryIndex::ExeKey(j.path);
+    FingerprintResult r;
+    r.path = j.path;
+    r.tag  = j.tag;
+
+    std::error_code ec;
+    uint64_t  size  = fs::file_size(j.path, ec);
+    long long mtime = ec ? 0 : (long long)fs::last_write_time(j.path, ec).time_since_epoch().count();
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        Entry& e = m_cache[key];
+        e.used   = true;
+        if (ec) {
+            // Gone: report what it used to be.
+            r.exists = false;
+            r.print  = e.print;
+        } else if (e.print.Valid() && e.size == size && e.mtime == mtime) {
+            return;   // unchanged, and the caller already has it from Find
+        }
+    }
+    if (r.exists && !Compute(j.path, r.print)) return;
+
+    std::lock_guard<std::mutex> l(m_mutex);
+    if (r.exists) {
+        Entry& e = m_cache[key];
+        e.size   = size;
+        e.mtime  = mtime;
+        e.print  = r.print;
+        m_dirty  = true;
+    }
+    std::lock_guard<std::mutex> d(m_doneMutex);
+    m_done.push_back(std::move(r));
+}
+
+void FingerprintIndex::Run() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+    for (;;) {
+        Job j;
+        {
+            std::unique_lock<std::mutex> l(m_mutex);
+            m_cv.wait(l, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            j = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy++;
+        }
+        Process(j);
+        bool idle;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            idle = --m_busy == 0 && m_queue.empty() && m_dirty;
+        }
+        if (idle) Save(false);   // once per burst, by whichever thread finishes it
+    }
+}
+
+// ─── Persistence ─────────────────────────────────────────────────────────────
+
+void FingerprintIndex::Load(const std::string& path) {
+    if (!m_threads.empty()) return;
+    m_path = path;
+    {
+        std::ifstream f(path);
+        std::string line;
+        if (std::getline(f, line) && line == "QPRINT1") {
+            std::lock_guard<std::mutex> l(m_mutex);
+            while (std::getline(f, line)) {
+                std::vector<std::string> p;
+                std::stringstream ss(line);
+                for (std::string t; std::getline(ss, t, '|');) p.push_back(t);
+                if (p.size() != 5 || p[0] != "F") continue;
+                try {
+                    Entry& e     = m_cache[std::stoull(p[1], nullptr, 16)];
+                    e.size       = std::stoull(p[2]);
+                    e.mtime      = std::stoll(p[3]);
+                    e.print.size = e.size;
+                    e.print.hash = std::stoull(p[4], nullptr, 16);
+                } catch (...) {}   // one bad line loses one entry
+            }
+        }
+    }
+    m_stop = false;
+    std::lock_guard<std::mutex> l(m_mutex);
+    for (unsigned i = 0; i < THREADS; i++) m_threads.emplace_back(&FingerprintIndex::Run, this);
+}
+
+void FingerprintIndex::Save(bool prune) {
+    // Two threads can each finish a burst; the second waits, then writes the
+    // newer snapshot over the first.
+    std::lock_guard<std::mutex> s(m_saveMutex);
+    std::ostringstream o;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_dirty = false;
+        o << "QPRINT1\n";
+        char buf[96];
+        for (auto& [key, e] : m_cache) {
+            if (!e.print.Valid() || (prune && !e.used)) continue;
+            snprintf(buf, sizeof(buf), "F|%016" PRIx64 "|%" PRIu64 "|%lld|%016" PRIx64 "\n",
+                     key, e.size, e.mtime, e.print.hash);
+            o << buf;
+        }
+    }
+    if (m_path.empty()) return;
+    std::string tmp = m_path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        f << o.str();
+        if (!f) return;
+    }
+    std::error_code ec;
+    fs::rename(tmp, m_path, ec);
+    if (ec) fs::remove(tmp, ec);
+}
+
+void FingerprintIndex::Stop() {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (m_threads.empty()) return;
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& t : m_threads) if (t.joinable()) t.join();
+    m_threads.clear();
+    Save(true);
+}
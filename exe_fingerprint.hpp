@@ -0,0 +1,113 @@
+// ============================================================================
+// EXE_FINGERPRINT.HPP - Q-SHELL v3.0
+// Content fingerprints of game executables, for recognising moved installs.
+//
+// A fingerprint is the exe's size plus an XXH64 of its first and last 64 KB
+// (seeded with the size). That is enough to tell builds apart, costs two
+// small reads however large the exe is, and does not change when the folder
+// is moved to another drive. The library compares fingerprints of entries
+// whose exe has gone missing against newly seen exes and rebinds the old
+// entry instead of keeping a dead duplicate.
+//
+// Hashing runs on two background threads. Results are cached by
+// (exe path, size, mtime) in profile\fingerprints.txt, so an unchanged exe
+// is never read twice; a path whose exe has disappeared keeps its last known
+// fingerprint, which is exactly what a later rebind needs.
+//
+// Only news is reported: a new or changed fingerprint, or a missing exe.
+// Finished requests are batched and handed to the listener from
+// DispatchCompletions() on the UI thread.
+// ============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+uint64_t XXH64(const void* data, size_t len, uint64_t seed);
+
+struct ExeFingerprint {
+    uint64_t size = 0, hash = 0;
+    bool Valid() const { return size != 0; }
+    bool operator==(const ExeFingerprint& o) const { return size == o.size && hash == o.hash; }
+    bool operator!=(const ExeFingerprint& o) const { return !(*this == o); }
+};
+
+struct FingerprintResult {
+    std::string    path;
+    uint64_t       tag = 0;          // the caller's, from Request
+    ExeFingerprint print;            // last known when the exe is missing
+    bool           exists = true;
+};
+
+class FingerprintIndex {
+public:
+    using Listener = std::function<void(const std::vector<FingerprintResult>&)>;
+
+    FingerprintIndex() = default;
+    ~FingerprintIndex() { Stop(); }
+    FingerprintIndex(const FingerprintIndex&)            = delete;
+    FingerprintIndex& operator=(const FingerprintIndex&) = delete;
+
+    // Reads the cache and starts the hashing threads.
+    void Load(const std::string& path);
+
+    // Checks exePath against the cache, hashing it if it changed.
+    void Request(const std::string& exePath, uint64_t tag);
+
+    // Cached fingerprint for exePath, without touching the file.
+    bool Find(const std::string& exePath, ExeFingerprint& out) const;
+
+    void SetListener(Listener l) { m_listener = std::move(l); }
+    void DispatchCompletions();
+
+    // Joins the threads and saves the cache, keeping only paths requested
+    // this session.
+    void Stop();
+
+    // Reads the head and tail of path. False if it can't be read.
+    static bool Compute(const std::string& path, ExeFingerprint& out);
+
+private:
+    struct Entry {
+        uint64_t       size  = 0;
+        long long      mtime = 0;
+        ExeFingerprint print;
+        bool           used  = false;   // requested this session
+    };
+    struct Job {
+        std::string path;
+        uint64_t    tag = 0;
+    };
+
+    void Run();
+    void Process(const Job& j);
+    void Save(bool prune);
+
+    std::string              m_path;
+    std::mutex               m_saveMutex;   // one writer of the .tmp at a time
+    std::vector<std::thread> m_threads;
+    std::atomic<bool>        m_stop{ false };
+
+    mutable std::mutex                     m_mutex;
+    std::condition_variable                m_cv;
+    std::deque<Job>                        m_queue;
+    unsigned                               m_busy  = 0;
+    bool                                   m_dirty = false;
+    std::unordered_map<uint64_t, Entry>    m_cache;   // LibraryIndex::ExeKey -> entry
+
+    std::mutex                     m_doneMutex;
+    std::vector<FingerprintResult> m_done;
+    Listener                       m_listener;
+};
+
+FingerprintIndex& Fingerprints();
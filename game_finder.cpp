@@ -1,12 +1,21 @@
 #include "game_finder.hpp"
+#include "task_pool.hpp"
+#include "scan_index.hpp"
+#include "pe_reader.hpp"
+#include "vdf_parser.hpp"
+#include "json_reader.hpp"
+#include "art_fetcher.hpp"
+#include "image_info.hpp"
+#include "art_store.hpp"
 
 // --- WINDOWS COMPATIBILITY (FIXES LPMSG ERROR) ---
 #define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
 #define NOGDI
 #define CloseWindow Win32CloseWindow
 #define ShowCursor Win32ShowCursor
 #include <windows.h>
-#include <urlmon.h> 
+#include <winioctl.h>
 #undef CloseWindow
 #undef ShowCursor
 // --------------------------------------------------
@@ -14,10 +23,22 @@
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <climits>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
-#pragma comment(lib, "urlmon.lib")
 namespace fs = std::filesystem;
 
+void DebugLog(const std::string& msg);   // qshell.cpp
+
 // 1. DYNAMIC CLEANER
 // Handles "Rocket League®|Path" -> "Rocket League"
 static std::string CleanGameName(std::string name) {
@@ -36,132 +57,572 @@ static std::string CleanGameName(std::string name) {
     return (first == std::string::npos) ? "" : name.substr(first);
 }
 
-// 2. THE ART LOGIC - FIXED TO SAVE WITH EXACT NAME (NO UNDERSCORES)
-void DownloadArt(std::string name, std::string id) {
-    if (!fs::exists("img")) fs::create_directory("img");
-    
-    // CRITICAL FIX: Save with exact name, don't replace spaces
-    std::string path = "img/" + name + ".jpg";
+// Platform interning. A deque keeps every name at a fixed address, so
+// PlatformName() references (and the c_str handed to plugins) never move.
+// Ids only grow: a name's address goes into a fixed table before the count
+// that covers it is published, so PlatformName() - per card, per frame - reads
+// without the lock. Only InternPlatform takes it.
+static std::mutex               g_platformMutex;
+static std::deque<std::string>  g_platformNames = { "", "Steam", "Epic", "Manual" };
+static const std::string*       g_platformTable[256] = { &g_platformNames[0], &g_platformNames[1],
+                                                         &g_platformNames[2], &g_platformNames[3] };
+static std::atomic<size_t>      g_platformCount{ 4 };
 
-    if (fs::exists(path)) return;
+uint8_t InternPlatform(const std::string& name) {
+    std::lock_guard<std::mutex> l(g_platformMutex);
+    for (size_t i = 0; i < g_platformNames.size(); i++)
+        if (g_platformNames[i] == name) return (uint8_t)i;
+    if (g_platformNames.size() > 255) return PLATFORM_NONE;
+    g_platformNames.push_back(name);
+    size_t id = g_platformNames.size() - 1;
+    g_platformTable[id] = &g_platformNames.back();
+    g_platformCount.store(id + 1, std::memory_order_release);
+    return (uint8_t)id;
+}
 
-    // Check if ID is numeric
-    bool isNumeric = !id.empty() && std::all_of(id.begin(), id.end(), ::isdigit);
-    
-    std::string url;
-    if (isNumeric) {
-        url = "https://cdn.akamai.steamstatic.com/steam/apps/" + id + "/header.jpg";
-    } else {
-        // Fallback for Epic/Codenames: try common game IDs
-        // You can expand this list for better Epic game support
-        url = "https://cdn.akamai.steamstatic.com/steam/apps/252950/header.jpg";
+const std::string& PlatformName(uint8_t id) {
+    return id < g_platformCount.load(std::memory_order_acquire) ? *g_platformTable[id] : *g_platformTable[PLATFORM_NONE];
+}
+
+// 2. THE ART LOGIC
+// Steam already caches header / capsule / portrait / hero art for every owned
+// game in appcache\librarycache, either flat (<appid>_header.jpg,
+// <appid>_library_600x900.jpg, ...) or, on newer clients, in a per-appid
+// folder. The folder is listed once into appid -> files (and re-listed only
+// when its mtime moves); per game we read just the candidates' image headers
+// and hand the one whose aspect best fits the active skin's card to the art
+// store. The CDN is only asked when Steam has nothing locally. Epic catalog
+// ids have no CDN path, so those games get no art rather than someone else's
+// header.
+static std::string GetSteamInstallDir();   // 5. LIBRARY ROOTS
+
+static std::atomic<float> g_posterAspect{ 480.f / 270.f };
+
+void SetPreferredPosterAspect(float aspect) {
+    if (aspect > 0) g_posterAspect = aspect;
+}
+
+struct LibraryCache {
+    std::string                                               dir;
+    int64_t                                                   mtime = -1;
+    std::unordered_map<std::string, std::vector<std::string>> byApp;
+};
+static std::mutex   g_libCacheMutex;
+static LibraryCache g_libCache;
+
+static bool IsPosterCandidate(const fs::path& p) {
+    std::string f = p.filename().string(), ext = p.extension().string();
+    std::transform(f.begin(), f.end(), f.begin(), ::tolower);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext != ".jpg" && ext != ".png") return false;
+    for (const char* skip : { "logo", "icon", "blur" })   // transparent or not a poster
+        if (f.find(skip) != std::string::npos) return false;
+    return true;
+}
+
+static std::vector<std::string> LibraryCacheFiles(const std::string& appId) {
+    std::lock_guard<std::mutex> l(g_libCacheMutex);
+    if (g_libCache.dir.empty()) {
+        std::string steam = GetSteamInstallDir();
+        if (steam.empty()) return {};
+        g_libCache.dir = steam + "\\appcache\\librarycache";
+    }
+    std::error_code ec;
+    auto t = fs::last_write_time(g_libCache.dir, ec);
+    if (ec) return {};
+    int64_t mtime = (int64_t)t.time_since_epoch().count();
+    if (mtime != g_libCache.mtime) {
+        g_libCache.mtime = mtime;
+        g_libCache.byApp.clear();
+        for (fs::directory_iterator it(g_libCache.dir, ec), end; !ec && it != end; it.increment(ec)) {
+            std::string n = it->path().filename().string();
+            size_t digits = 0;
+            while (digits < n.size() && isdigit((unsigned char)n[digits])) digits++;
+            if (!digits) continue;
+            std::error_code dec;
+            if (digits == n.size() && it->is_directory(dec)) {
+                auto& files = g_libCache.byApp[n];
+                for (fs::recursive_directory_iterator r(it->path(), dec), rend; !dec && r != rend; r.increment(dec))
+                    if (IsPosterCandidate(r->path())) files.push_back(r->path().string());
+            } else if (n[digits] == '_' && IsPosterCandidate(it->path())) {
+                g_libCache.byApp[n.substr(0, digits)].push_back(it->path().string());
+            }
+        }
     }
+    auto it = g_libCache.byApp.find(appId);
+    return it != g_libCache.byApp.end() ? it->second : std::vector<std::string>{};
+}
 
-    URLDownloadToFileA(NULL, url.c_str(), path.c_str(), 0, NULL);
+// Best fit = smallest |log(image aspect / card aspect)|; near-ties (within
+// ~5%) go to the larger image, so library_600x900_2x beats library_600x900.
+std::string FindLocalSteamArt(const std::string& appId, float aspect) {
+    std::string best;
+    double bestFit = 1e9, bestArea = 0;
+    for (auto& f : LibraryCacheFiles(appId)) {
+        int w, h;
+        if (!ReadImageSize(f, w, h)) continue;
+        double fit = std::fabs(std::log((double)w / h / aspect)), area = (double)w * h;
+        if (fit < bestFit - 0.05 || (fit < bestFit + 0.05 && area > bestArea)) {
+            if (fit < bestFit) bestFit = fit;
+            bestArea = area;
+            best = f;
+        }
+    }
+    return best;
 }
 
-// 3. EXE FINDER (Skips installers/redists)
-static std::string FindActualGameExe(const std::string& directory) {
-    if (!fs::exists(directory)) return "";
+void DownloadArt(const GameInfo& g) {
+    const std::string& id = g.appId;
+    if (id.empty() || !std::all_of(id.begin(), id.end(), ::isdigit)) return;
+    uint64_t key = ArtStore::KeyFor(g);
+    if (Posters().Has(key)) return;
+    std::string tag   = ArtStore::KeyString(key);
+    std::string local = FindLocalSteamArt(id, g_posterAspect);
+    if (!local.empty()) {
+        Art().Import(local, Posters().IncomingPath(key, fs::path(local).extension().string()), tag);
+        return;
+    }
+    Art().Fetch(Art().BaseUrl() + id + "/header.jpg", Posters().IncomingPath(key, ".jpg"), tag);
+}
+
+// 3. EXE FINDER (scores candidates from their PE headers)
+// The install tree is walked breadth-first so top-level binaries are seen
+// before anything buried in tools/ or redist/ folders. Each candidate costs a
+// few KB of header reads (see pe_reader), never a full stat or file read, and
+// the walk stops as soon as a candidate clears EXE_CONFIDENT.
+static const int EXE_CONFIDENT = 100;
+static const int EXE_MAX_DEPTH = 6;
+
+// Lowercase alphanumerics only: "DOOM Eternal" / "DOOMEternalx64vk" compare.
+static std::string NormalizeForMatch(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (unsigned char c : s) if (std::isalnum(c)) out += (char)std::tolower(c);
+    return out;
+}
+
+static int MatchScore(const std::string& candidate, const std::string& target, int full, int partial) {
+    if (candidate.size() < 3 || target.size() < 3) return 0;
+    if (candidate == target) return full;
+    if (candidate.find(target) != std::string::npos || target.find(candidate) != std::string::npos) return partial;
+    return 0;
+}
+
+static bool HasAny(const std::string& s, std::initializer_list<const char*> words) {
+    for (const char* w : words) if (s.find(w) != std::string::npos) return true;
+    return false;
+}
+
+static int ScoreExecutable(const fs::path& exe, int depth, const std::string& gameKey, const std::string& dirKey) {
+    std::string fn = exe.stem().string();
+    std::transform(fn.begin(), fn.end(), fn.begin(), ::tolower);
+
+    // IGNORE REDISTS, UNINSTALLERS AND CRASH/ANTI-CHEAT HELPERS. Only names
+    // that are never a game are skipped outright, and never one that matches
+    // the game or its folder: CrashBandicootNSaneTrilogy.exe is the game.
+    // Looser words ("crash", "install", ...) only cost score further down.
+    std::string stem = NormalizeForMatch(fn);
+    bool named = MatchScore(stem, gameKey, 1, 1) || MatchScore(stem, dirKey, 1, 1);
+    if (!named && HasAny(fn, { "crashhandler", "crashreporter", "unitycrashhandler", "unins0", "vc_redist",
+                               "redist", "dxsetup", "setup", "helper", "easyanticheat", "battleye" })) return INT_MIN;
+
+    PEInfo pe;
+    if (!ReadPEInfo(exe.string(), pe) || pe.isDll) return INT_MIN;
+
+    int score = 0;
+    if (pe.subsystem == PE_SUBSYSTEM_GUI)          score += 40;
+    else if (pe.subsystem == PE_SUBSYSTEM_CONSOLE) score -= 30;
+
+    if (pe.machine == PE_MACHINE_AMD64)      score += 15;
+    else if (pe.machine == PE_MACHINE_I386)  score += 5;
+    else if (pe.machine != PE_MACHINE_ARM64) score -= 50;
+
+    std::string product = NormalizeForMatch(pe.productName);
+    std::string desc    = NormalizeForMatch(pe.fileDescription);
+    if (HasAny(product + " " + desc, { "redistributable", "directx", "installer", "crashreport", "anticheat" })) score -= 80;
+    score += std::max({ MatchScore(product, gameKey, 60, 40), MatchScore(desc, gameKey, 40, 25),
+                        MatchScore(product, dirKey, 40, 25) });
+
+    score += std::max(MatchScore(stem, gameKey, 40, 25), MatchScore(stem, dirKey, 30, 20));
+    if (HasAny(fn, { "launcher", "config", "settings", "editor", "server", "benchmark" })) score -= 20;
+    if (!named && HasAny(fn, { "crash", "report", "install", "unins", "prereq" })) score -= 60;
+
+    return score - depth * 8;
+}
+
+// Per-install-directory cache. The key is the install directory; an entry is
+// reused while the directory's own mtime is unchanged and the chosen exe still
+// exists, which covers repeated resolves of the same game within a session.
+struct ExeCacheEntry {
+    int64_t     dirMtime = 0;
+    std::string exe;
+};
+static std::mutex                                     g_exeCacheMutex;
+static std::unordered_map<std::string, ExeCacheEntry> g_exeCache;
+
+static std::string FindActualGameExe(const std::string& directory, const std::string& gameName) {
+    std::error_code ec;
+    auto dirTime = fs::last_write_time(directory, ec);
+    if (ec) return "";
+    int64_t dirMtime = (int64_t)dirTime.time_since_epoch().count();
+
+    {
+        std::lock_guard<std::mutex> l(g_exeCacheMutex);
+        auto it = g_exeCache.find(directory);
+        if (it != g_exeCache.end() && it->second.dirMtime == dirMtime && fs::exists(it->second.exe, ec))
+            return it->second.exe;
+    }
+
+    std::string gameKey = NormalizeForMatch(gameName);
+    std::string dirKey  = NormalizeForMatch(fs::path(directory).filename().string());
+
     std::string best;
-    uintmax_t maxS = 0;
-    try {
-        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".exe") {
-                std::string fn = entry.path().filename().string();
-                std::transform(fn.begin(), fn.end(), fn.begin(), ::tolower);
-                
-                // IGNORE REDISTS AND INSTALLERS
-                if (fn.find("redist") != std::string::npos || fn.find("setup") != std::string::npos || 
-                    fn.find("vcredist") != std::string::npos || fn.find("helper") != std::string::npos) continue;
-
-                uintmax_t size = fs::file_size(entry.path());
-                if (size > maxS) { maxS = size; best = entry.path().string(); }
+    int bestScore = INT_MIN;
+    std::vector<fs::path> level = { directory }, next;
+    for (int depth = 0; depth <= EXE_MAX_DEPTH && !level.empty() && bestScore < EXE_CONFIDENT; depth++) {
+        next.clear();
+        for (const fs::path& d : level) {
+            for (fs::directory_iterator it(d, ec), end; !ec && it != end; it.increment(ec)) {
+                std::error_code tec;
+                if (it->is_directory(tec)) {
+                    std::string sub = it->path().filename().string();
+                    std::transform(sub.begin(), sub.end(), sub.begin(), ::tolower);
+                    if (!HasAny(sub, { "redist", "directx", "__installer", "easyanticheat", "battleye", "support" }))
+                        next.push_back(it->path());
+                    continue;
+                }
+                std::string ext = it->path().extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+                if (ext != ".exe") continue;
+
+                int score = ScoreExecutable(it->path(), depth, gameKey, dirKey);
+                if (score > bestScore) { bestScore = score; best = it->path().string(); }
             }
+            ec.clear();
         }
-    } catch(...) {}
+        std::sort(next.begin(), next.end());
+        level.swap(next);
+    }
+
+    if (!best.empty()) {
+        std::lock_guard<std::mutex> l(g_exeCacheMutex);
+        g_exeCache[directory] = { dirMtime, best };
+    }
     return best;
 }
 
-std::vector<GameInfo> GetInstalledGames() {
-    std::vector<GameInfo> games;
-    HKEY hKey;
+// 4. MANIFEST PARSERS (one manifest in, at most one game out)
+static bool ParseSteamManifest(const fs::path& acf, const std::string& apps, GameInfo& out) {
+    VdfDocument doc;
+    if (!doc.Load(acf.string())) return false;
+    VdfNode state = doc.Root().Find("AppState");
+    if (!state) return false;
+
+    // ID from filename (appmanifest_<id>.acf), falling back to the "appid" key
+    std::string fn = acf.filename().string();
+    size_t s = fn.find('_'), e = fn.find('.');
+    std::string appId = (s != std::string::npos && e > s) ? fn.substr(s + 1, e - s - 1)
+                                                          : std::string(state.Get("appid"));
+    std::string rawName = state.Find("name").String();
+    std::string dir     = state.Find("installdir").String();
+
+    // FILTER: Skip anything containing "Steamworks" or "Redistributable"
+    if (rawName.empty() || dir.empty() || rawName.find("Steamworks") != std::string::npos) return false;
+    std::string name = CleanGameName(rawName);
+    std::string exe  = FindActualGameExe(apps + "\\common\\" + dir, name);
+    if (exe.empty()) return false;
+    out = { name, exe, "Steam", appId };
+    return true;
+}
+
+static bool ParseEpicManifest(const fs::path& item, GameInfo& out) {
+    MappedFile f;
+    if (!f.Open(item.string())) return false;
+
+    // Only four top-level strings are needed; stop reading once all are in.
+    struct Field { const char* key; std::string value; };
+    Field fields[] = { { "DisplayName", {} }, { "InstallLocation", {} },
+                       { "AppName", {} },     { "LaunchExecutable", {} } };
+    const unsigned ALL = (1u << 4) - 1;
+    unsigned found = 0;
+
+    JsonReader r(f.View());
+    if (r.Next() != JsonToken::ObjectBegin) return false;
+    while (found != ALL) {
+        JsonToken t = r.Next();
+        if (t != JsonToken::Key) break;   // ObjectEnd, or malformed input
 
-    // --- 1. STEAM SCAN ---
-    char steamPath[MAX_PATH];
+        int hit = -1;
+        for (int i = 0; i < 4; i++) if (r.Raw() == fields[i].key) { hit = i; break; }
+        if (hit < 0) { if (!r.Skip()) break; continue; }
+
+        t = r.Next();
+        if (t == JsonToken::String) { fields[hit].value = r.Text(); found |= 1u << hit; }
+        else if ((t == JsonToken::ObjectBegin || t == JsonToken::ArrayBegin) && !r.SkipToEnd()) break;
+        else if (t == JsonToken::Error || t == JsonToken::End) break;
+    }
+
+    const std::string& rawName = fields[0].value;
+    const std::string& loc     = fields[1].value;
+    if (rawName.empty() || loc.empty()) return false;
+    out = { CleanGameName(rawName), loc + "\\" + fields[3].value, "Epic", fields[2].value };
+    return true;
+}
+
+// Sorted listing so job order (and therefore output order) never depends on
+// the order the filesystem happens to return entries in. Size and mtime come
+// from the directory entry (FindNextFile already returned them on Windows), so
+// this is the only filesystem work an unchanged manifest costs.
+struct ManifestStat {
+    fs::path path;
+    uint64_t size  = 0;
+    int64_t  mtime = 0;
+};
+
+static std::vector<ManifestStat> ListManifests(const std::string& dir, const char* ext) {
+    std::vector<ManifestStat> out;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ext) continue;
+        std::error_code sec;
+        ManifestStat m;
+        m.path  = it->path();
+        m.size  = it->file_size(sec);
+        m.mtime = (int64_t)it->last_write_time(sec).time_since_epoch().count();
+        if (!sec) out.push_back(std::move(m));
+    }
+    std::sort(out.begin(), out.end(), [](const ManifestStat& a, const ManifestStat& b) { return a.path < b.path; });
+    return out;
+}
+
+// 5. LIBRARY ROOTS
+// Steam keeps every library folder (C:\Program Files (x86)\Steam, D:\SteamLibrary,
+// ...) in <InstallPath>\steamapps\libraryfolders.vdf. Newer clients write
+// "libraryfolders" { "0" { "path" "..." } }, older ones "LibraryFolders" { "1" "..." }.
+static std::string GetSteamInstallDir() {
+    char steamPath[MAX_PATH] = {};
     DWORD sz = sizeof(steamPath);
+    HKEY hKey;
     if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "SOFTWARE\\WOW6432Node\\Valve\\Steam", 0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExA(hKey, "InstallPath", NULL, NULL, (LPBYTE)steamPath, &sz) == ERROR_SUCCESS) {
-            std::string apps = std::string(steamPath) + "\\steamapps";
-            for (const auto& entry : fs::directory_iterator(apps)) {
-                if (entry.path().extension() == ".acf") {
-                    std::ifstream f(entry.path());
-                    std::string line, rawName, dir, appId;
-                    
-                    // ID from filename
-                    std::string fn = entry.path().filename().string();
-                    size_t s = fn.find('_'), e = fn.find('.');
-                    appId = fn.substr(s + 1, e - s - 1);
-
-                    while (std::getline(f, line)) {
-                        if (line.find("\"name\"") != std::string::npos && rawName.empty()) {
-                            size_t p1 = line.find("\"", line.find("\"name\"") + 6), p2 = line.find("\"", p1 + 1);
-                            rawName = line.substr(p1 + 1, p2 - p1 - 1);
-                        }
-                        if (line.find("\"installdir\"") != std::string::npos) {
-                            size_t p1 = line.find("\"", line.find("\"installdir\"") + 12), p2 = line.find("\"", p1 + 1);
-                            dir = line.substr(p1 + 1, p2 - p1 - 1);
-                        }
-                    }
-
-                    // FILTER: Skip anything containing "Steamworks" or "Redistributable"
-                    if (!rawName.empty() && rawName.find("Steamworks") == std::string::npos) {
-                        std::string exe = FindActualGameExe(apps + "\\common\\" + dir);
-                        if (!exe.empty()) {
-                            std::string clean = CleanGameName(rawName);
-                            games.push_back({clean, exe, "Steam", appId});
-                            DownloadArt(clean, appId);
-                        }
-                    }
-                }
-            }
-        }
+        if (RegQueryValueExA(hKey, "InstallPath", NULL, NULL, (LPBYTE)steamPath, &sz) != ERROR_SUCCESS) steamPath[0] = 0;
         RegCloseKey(hKey);
     }
+    return steamPath;
+}
+
+static std::string PathKey(std::string p) {
+    while (!p.empty() && (p.back() == '\\' || p.back() == '/')) p.pop_back();
+    std::transform(p.begin(), p.end(), p.begin(), ::tolower);
+    std::replace(p.begin(), p.end(), '/', '\\');
+    return p;
+}
+
+static std::vector<std::string> GetSteamLibraryRoots() {
+    std::vector<std::string> roots;
+    std::string steam = GetSteamInstallDir();
+    if (steam.empty()) return roots;
+
+    std::vector<std::string> seen;
+    auto add = [&](const std::string& lib) {
+        std::string apps = lib + "\\steamapps";
+        std::string key  = PathKey(apps);
+        if (std::find(seen.begin(), seen.end(), key) != seen.end()) return;
+        std::error_code ec;
+        if (!fs::is_directory(apps, ec)) return;
+        seen.push_back(key);
+        roots.push_back(apps);
+    };
+    add(steam);
+
+    VdfDocument doc;
+    if (doc.Load(steam + "\\steamapps\\libraryfolders.vdf")) {
+        for (VdfNode n = doc.Root().Find("libraryfolders").FirstChild(); n; n = n.Next()) {
+            std::string_view k = n.Key();
+            if (n.IsObject())                                            add(n.Find("path").String());
+            else if (!k.empty() && std::all_of(k.begin(), k.end(), ::isdigit)) add(n.String());
+        }
+    }
+    return roots;
+}
+
+// Volume a path lives on ("D:\" or a mount-point root), used to give each
+// drive its own workers.
+static std::string VolumeOf(const std::string& path) {
+    char vol[MAX_PATH] = {};
+    if (GetVolumePathNameA(path.c_str(), vol, MAX_PATH)) return PathKey(vol);
+    return PathKey(fs::path(path).root_name().string());
+}
+
+// Spinning disks get a single worker - parallel seeks across an install tree
+// are slower than one sequential walk. Anything we can't query is treated as
+// solid state.
+static bool VolumeHasSeekPenalty(const std::string& volume) {
+    if (volume.size() < 2 || volume[1] != ':') return false;
+    std::string dev = "\\\\.\\" + volume.substr(0, 2);
+    HANDLE h = CreateFileA(dev.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    STORAGE_PROPERTY_QUERY q = {};
+    q.PropertyId = StorageDeviceSeekPenaltyProperty;
+    q.QueryType  = PropertyStandardQuery;
+    DEVICE_SEEK_PENALTY_DESCRIPTOR d = {};
+    DWORD ret = 0;
+    BOOL ok = DeviceIoControl(h, IOCTL_STORAGE_QUERY_PROPERTY, &q, sizeof(q), &d, sizeof(d), &ret, nullptr);
+    CloseHandle(h);
+    return ok && ret >= sizeof(d) && d.IncursSeekPenalty;
+}
+
+static const char* const EPIC_MANIFEST_DIR = "C:\\ProgramData\\Epic\\EpicGamesLauncher\\Data\\Manifests";
+
+std::vector<std::string> GetManifestDirectories() {
+    std::vector<std::string> dirs = GetSteamLibraryRoots();
+    std::error_code ec;
+    if (fs::is_directory(EPIC_MANIFEST_DIR, ec)) dirs.push_back(EPIC_MANIFEST_DIR);
+    return dirs;
+}
+
+bool ResolveManifest(const std::string& manifestPath, GameInfo& out) {
+    fs::path p(manifestPath);
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".item") return ParseEpicManifest(p, out);
+    if (ext == ".acf")  return ParseSteamManifest(p, p.parent_path().string(), out);
+    return false;
+}
+
+// 6. PARALLEL SCAN
+// Every library root (each Steam library's steamapps, plus the Epic manifest
+// folder) is scanned by the worker that owns its volume, so a slow HDD never
+// holds up an NVMe library. Within a root, manifests whose size and mtime
+// match the persisted scan index reuse the cached result and the rest are
+// resolved on that volume's pool. Each root writes only its own slots, so the
+// merge is a walk over roots in discovery order, manifests sorted by path.
+//
+// Results stream out through onGame as they become known: cache hits right
+// after their root is listed, misses as each one resolves. onGame is called
+// from scanner threads. Setting cancel abandons outstanding work and leaves
+// the persisted index untouched. The return value is the complete list in the
+// deterministic merge order (empty if cancelled).
+std::vector<GameInfo> ScanInstalledGames(const GameCallback& onGame, const std::atomic<bool>& cancel) {
+    struct ScanRoot {
+        std::string                 dir;
+        bool                        epic = false;
+        std::string                 volume;
+        std::vector<ScanIndexEntry> slots;
+        int                         parsed = 0;
+    };
+    std::vector<ScanRoot> roots;
+
+    // --- 1. DISCOVER ROOTS ---
+    for (auto& apps : GetSteamLibraryRoots()) roots.push_back({ apps, false });
+    roots.push_back({ EPIC_MANIFEST_DIR, true });
+
+    std::vector<std::string> volumes;
+    for (auto& r : roots) {
+        r.volume = VolumeOf(r.dir);
+        if (std::find(volumes.begin(), volumes.end(), r.volume) == volumes.end()) volumes.push_back(r.volume);
+    }
+
+    ScanIndex oldIndex;
+    oldIndex.Load(SCAN_INDEX_FILE);
+
+    std::atomic<int64_t> epicUs{ 0 };
+    std::atomic<int>     epicCount{ 0 };
 
-    // --- 2. EPIC SCAN ---
-    std::string epicPath = "C:\\ProgramData\\Epic\\EpicGamesLauncher\\Data\\Manifests";
-    if (fs::exists(epicPath)) {
-        for (const auto& entry : fs::directory_iterator(epicPath)) {
-            if (entry.path().extension() == ".item") {
-                std::ifstream f(entry.path());
-                std::string line, rawName, loc, exe, id;
-                while (std::getline(f, line)) {
-                    if (line.find("\"DisplayName\"") != std::string::npos) {
-                        size_t p1 = line.find("\"", line.find("\"DisplayName\"") + 13), p2 = line.find("\"", p1 + 1);
-                        rawName = line.substr(p1 + 1, p2 - p1 - 1);
-                    }
-                    if (line.find("\"InstallLocation\"") != std::string::npos) {
-                        size_t p1 = line.find("\"", line.find("\"InstallLocation\"") + 17), p2 = line.find("\"", p1 + 1);
-                        loc = line.substr(p1 + 1, p2 - p1 - 1);
-                    }
-                    if (line.find("\"AppName\"") != std::string::npos) {
-                        size_t p1 = line.find("\"", line.find("\"AppName\"") + 9), p2 = line.find("\"", p1 + 1);
-                        id = line.substr(p1 + 1, p2 - p1 - 1);
-                    }
-                    if (line.find("\"LaunchExecutable\"") != std::string::npos) {
-                        size_t p1 = line.find("\"", line.find("\"LaunchExecutable\"") + 18), p2 = line.find("\"", p1 + 1);
-                        exe = line.substr(p1 + 1, p2 - p1 - 1);
-                    }
+    // --- 2. ONE WORKER GROUP PER VOLUME ---
+    // Roots on the same volume are taken one after another (they share the
+    // disk anyway), which also makes the per-root time in the log exact.
+    auto scanVolume = [&](const std::string& volume) {
+        unsigned width = VolumeHasSeekPenalty(volume) ? 1u : TaskPool::DefaultThreads();
+        std::unique_ptr<TaskPool> pool;
+
+        for (auto& root : roots) {
+            if (root.volume != volume) continue;
+            if (cancel) break;
+            auto t0 = std::chrono::steady_clock::now();
+
+            auto manifests = ListManifests(root.dir, root.epic ? ".item" : ".acf");
+            root.slots.resize(manifests.size());
+            std::vector<size_t> misses;
+            for (size_t i = 0; i < manifests.size(); i++) {
+                const ManifestStat& m = manifests[i];
+                std::string key = m.path.string();
+                ScanIndexEntry& e = root.slots[i];
+                if (const ScanIndexEntry* hit = oldIndex.Find(key, m.size, m.mtime)) {
+                    e = *hit;
+                    if (e.resolved && onGame) onGame(e.game);
+                } else {
+                    e.manifest = key; e.size = m.size; e.mtime = m.mtime; misses.push_back(i);
                 }
-                
-                if (!rawName.empty() && !loc.empty()) {
-                    std::string clean = CleanGameName(rawName);
-                    games.push_back({clean, loc + "\\" + exe, "Epic", id});
-                    DownloadArt(clean, id);
+            }
+
+            if (!misses.empty()) {
+                if (!pool) pool = std::make_unique<TaskPool>(width);
+                for (size_t i : misses) {
+                    pool->Submit([&, i] {
+                        if (cancel) return;
+                        ScanIndexEntry& e = root.slots[i];
+                        if (root.epic) {
+                            auto p0 = std::chrono::steady_clock::now();
+                            e.resolved = ParseEpicManifest(manifests[i].path, e.game);
+                            epicUs += (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                                          std::chrono::steady_clock::now() - p0).count();
+                            epicCount++;
+                        } else {
+                            e.resolved = ParseSteamManifest(manifests[i].path, root.dir, e.game);
+                        }
+                        if (!e.resolved) return;
+                        if (onGame) onGame(e.game);
+                        DownloadArt(e.game);
+                    });
                 }
+                pool->Wait();
             }
+            root.parsed = (int)misses.size();
+
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            char msg[MAX_PATH + 128];
+            snprintf(msg, sizeof(msg), "[scan] %s %s: %zu manifests (%d parsed, %u workers) in %.2f ms",
+                     root.epic ? "epic" : "steam", root.dir.c_str(), manifests.size(), root.parsed,
+                     misses.empty() ? 0u : width, ms);
+            DebugLog(msg);
+        }
+    };
+
+    {
+        std::vector<std::thread> workers;
+        for (size_t v = 1; v < volumes.size(); v++) workers.emplace_back(scanVolume, volumes[v]);
+        if (!volumes.empty()) scanVolume(volumes[0]);
+        for (auto& t : workers) t.join();
+    }
+
+    if (epicCount) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "[scan] epic: %d manifests parsed in %.2f ms (%.1f us each)",
+                 epicCount.load(), epicUs.load() / 1000.0, (double)epicUs.load() / epicCount.load());
+        DebugLog(msg);
+    }
+
+    if (cancel) return {};
+
+    // --- 3. MERGE IN ROOT ORDER + PERSIST ---
+    // The new index holds exactly the manifests listed this time, which drops
+    // records for manifests that disappeared. Only rewritten when it changed.
+    ScanIndex newIndex;
+    std::vector<GameInfo> games;
+    bool changed = false;
+    for (auto& root : roots) {
+        changed |= root.parsed > 0;
+        for (auto& e : root.slots) {
+            if (e.resolved) games.push_back(e.game);
+            newIndex.Put(std::move(e));
         }
     }
+    if (changed || newIndex.Size() != oldIndex.Size()) newIndex.Save(SCAN_INDEX_FILE);
     return games;
 }
+
+std::vector<GameInfo> GetInstalledGames() {
+    std::atomic<bool> never{ false };
+    return ScanInstalledGames(nullptr, never);
+}
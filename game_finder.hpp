@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -14,5 +17,37 @@ struct GameInfo {
     std::string appId;
 };
 
+// Platform strings interned to a byte: per-frame code compares ids and draws
+// the shared name instead of each entry's own string. Unknown platforms get
+// ids on first sight.
+enum : uint8_t { PLATFORM_NONE = 0, PLATFORM_STEAM, PLATFORM_EPIC, PLATFORM_MANUAL };
+uint8_t            InternPlatform(const std::string& name);
+const std::string& PlatformName(uint8_t id);   // stable for the process lifetime
+
+// Full blocking scan; the complete list in a stable order.
 std::vector<GameInfo> GetInstalledGames();
-void DownloadArt(std::string name, std::string id);
\ No newline at end of file
+
+// Streaming scan: onGame fires (on scanner threads) for each game as soon as
+// it is known, so callers can show results before the walk finishes. Returns
+// the same list as GetInstalledGames, or nothing if cancel was raised.
+using GameCallback = std::function<void(const GameInfo&)>;
+std::vector<GameInfo> ScanInstalledGames(const GameCallback& onGame, const std::atomic<bool>& cancel);
+
+// Folders holding store manifests: every Steam library's steamapps plus Epic's
+// Manifests folder. These are what the library watcher listens on.
+std::vector<std::string> GetManifestDirectories();
+
+// Resolves a single .acf / .item manifest. False if it yields no game.
+bool ResolveManifest(const std::string& manifestPath, GameInfo& out);
+
+// Poster art for a store game that has none in the art store: taken from
+// Steam's librarycache when it has any, otherwise queued on the art fetcher.
+// Never blocks on the network.
+void DownloadArt(const GameInfo& g);
+
+// Best-fitting cached Steam art for appId at the given card aspect (w / h),
+// or "" if Steam has none locally.
+std::string FindLocalSteamArt(const std::string& appId, float aspect);
+
+// Card aspect the active skin wants (default 480x270). Set from the UI thread.
+void SetPreferredPosterAspect(float aspect);
\ No newline at end of file
@@ -69,39 +69,33 @@ static void hostimpl_push_notification(const char* t, const char* m,
 }
 
 static int hostimpl_get_game_count() {
-    extern AppState g_app;
-    return (int)g_app.library.size();
+    return LibraryRowCount();
 }
 
+// Game indices are rows of the active library view (see SetLibraryView) under
+// the active tag filter, so a skin walking 0..count draws exactly what the
+// built-in tab does.
 static void hostimpl_get_game(int idx, QShellGameInfo* out) {
     extern AppState g_app;
-    if (!out || idx < 0 || idx >= (int)g_app.library.size()) return;
-    auto& g        = g_app.library[idx];
+    int pos = LibraryAt(idx);
+    if (!out || pos < 0) return;
+    auto& g        = g_app.library[pos];
     out->name      = g.info.name.c_str();
     out->path      = g.info.exePath.c_str();
-    out->platform  = g.info.platform.c_str();
+    out->platform  = PlatformName(g.platform).c_str();   // interned: outlives the entry
     out->coverPath = "";
-    out->playtime_sec = 0;
-    out->last_played  = 0;
+    out->playtime_sec = g.playtimeSec;
+    out->last_played  = g.lastPlayed;
 }
 
 static void hostimpl_launch_game(int idx) {
-    extern AppState g_app;
-    if (idx < 0 || idx >= (int)g_app.library.size()) return;
-    ShellExecuteA(nullptr, "open",
-                  g_app.library[idx].info.exePath.c_str(),
-                  nullptr, nullptr, SW_SHOWNORMAL);
+    LaunchGame(LibraryAt(idx));   // same path as the built-in tab: the session is tracked
 }
 
 static void hostimpl_remove_game(int idx) {
-    extern AppState g_app;
-    if (idx < 0 || idx >= (int)g_app.library.size()) return;
-    // D2DBitmap: unload via renderer
-    if (g_app.library[idx].hasPoster)
-        D2D().UnloadBitmap(g_app.library[idx].poster);
-    g_app.library.erase(g_app.library.begin() + idx);
-    if (g_app.focused >= (int)g_app.library.size())
-        g_app.focused = std::max(0, (int)g_app.library.size() - 1);
+    int pos = LibraryAt(idx);
+    if (pos < 0) return;
+    RemoveLibraryEntryAt(pos);   // unloads the poster and keeps focus stable
 }
 
 static int hostimpl_get_focused_idx() {
@@ -207,6 +201,51 @@ static float hostimpl_get_time()          { return HostGetTime();         }
 static bool  hostimpl_is_shell_mode()     {
     extern AppState g_app; return g_app.isShellMode;
 }
+static int   hostimpl_search_library(const char* query, int* outIdx, int maxResults) {
+    if (!query || !outIdx || maxResults <= 0) return 0;
+    std::vector<int> hits;
+    SearchLibrary(query, maxResults, hits);
+    int n = 0;
+    for (int pos : hits) {
+        int row = LibraryRowOf(pos);
+        if (row >= 0) outIdx[n++] = row;   // filtered-out games have no index
+    }
+    return n;
+}
+
+static bool hostimpl_get_game_stats(int idx, QShellGameStats* out) {
+    extern AppState g_app;
+    int pos = LibraryAt(idx);
+    PlayStats st;
+    if (!out || pos < 0 || !Sessions().Find(g_app.library[pos].artKey, st)) return false;
+    long long now = (long long)time(nullptr);
+    out->playtime_sec  = st.playtime + (st.runningSince ? now - st.runningSince : 0);
+    out->last_played   = st.lastPlayed;
+    out->running_since = st.runningSince;
+    out->session_count = (int)st.sessions;
+    return true;
+}
+
+static int         hostimpl_get_library_view()      { extern AppState g_app; return g_app.libraryView; }
+static void        hostimpl_set_library_view(int v) { SetLibraryView(v); }
+static const char* hostimpl_get_library_view_name(int v) {
+    return (v >= 0 && v < VIEW_COUNT) ? LibraryViews::Name((LibraryView)v) : nullptr;
+}
+
+static void        hostimpl_set_library_filter(const char* expr) { SetLibraryFilter(expr ? expr : ""); }
+static const char* hostimpl_get_library_filter() {
+    static std::string ret; ret = LibraryFilterText(); return ret.c_str();
+}
+static int hostimpl_get_game_tags(int idx, char* buf, int len) {
+    std::string s;
+    for (auto& tag : LibraryTagsOf(LibraryAt(idx))) { if (!s.empty()) s += ','; s += tag; }
+    if (buf && len > 0) {
+        size_t n = std::min(s.size(), (size_t)len - 1);
+        memcpy(buf, s.data(), n);
+        buf[n] = 0;
+    }
+    return (int)s.size();
+}
 
 // ─── Filled host API table ────────────────────────────────────────────────────
 
@@ -232,4 +271,12 @@ static const QShellHostAPI g_hostAPI = {
     hostimpl_get_screen_height,
     hostimpl_get_time,
     hostimpl_is_shell_mode,
+    hostimpl_search_library,
+    hostimpl_get_library_view,
+    hostimpl_set_library_view,
+    hostimpl_get_library_view_name,
+    hostimpl_get_game_stats,
+    hostimpl_set_library_filter,
+    hostimpl_get_library_filter,
+    hostimpl_get_game_tags,
 };
@@ -0,0 +1,94 @@
+// ============================================================================
+// IMAGE_INFO.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "image_info.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+static inline uint32_t BE16(const uint8_t* p) { return (uint32_t)(p[0] << 8 | p[1]); }
+static inline uint32_t BE32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+static inline uint32_t LE16(const uint8_t* p) { return (uint32_t)(p[0] | p[1] << 8); }
+static inline uint32_t LE32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static bool ReadPng(std::ifstream& f, int& w, int& h) {
+    // 8-byte signature, then IHDR: length, "IHDR", width, height.
+    uint8_t b[24];
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(b), sizeof(b))) return false;
+    if (b[12] != 'I' || b[13] != 'H' || b[14] != 'D' || b[15] != 'R') return false;
+    w = (int)BE32(b + 16);
+    h = (int)BE32(b + 20);
+    return w > 0 && h > 0;
+}
+
+static bool ReadJpeg(std::ifstream& f, int& w, int& h) {
+    // Each step seeks over a whole segment, so a large EXIF block costs one
+    // read, not a scan; the walk ends at the frame header or the end of file.
+    uint64_t off = 2;   // past SOI
+    uint8_t  b[9];
+    for (;;) {
+        f.seekg((std::streamoff)off);
+        if (!f.read(reinterpret_cast<char*>(b), 4)) return false;
+        if (b[0] != 0xFF) return false;
+        uint8_t m = b[1];
+        if (m == 0xFF) { off++; continue; }                                 // fill byte
+        if (m == 0xD8 || m == 0x01 || (m >= 0xD0 && m <= 0xD7)) { off += 2; continue; }   // no length
+        if (m == 0xD9 || m == 0xDA) return false;                           // EOI / scan before a frame
+        uint32_t len = BE16(b + 2);
+        if (len < 2) return false;
+        // SOF0..SOF15 except DHT (C4), JPG (C8) and DAC (CC).
+        if (m >= 0xC0 && m <= 0xCF && m != 0xC4 && m != 0xC8 && m != 0xCC) {
+            if (!f.read(reinterpret_cast<char*>(b), 5)) return false;       // precision, height, width
+            h = (int)BE16(b + 1);
+            w = (int)BE16(b + 3);
+            return w > 0 && h > 0;
+        }
+        off += 2 + len;
+    }
+}
+
+static bool ReadGif(std::ifstream& f, int& w, int& h) {
+    // "GIF87a" / "GIF89a", then the logical screen width and height.
+    uint8_t b[10];
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(b), sizeof(b))) return false;
+    w = (int)LE16(b + 6);
+    h = (int)LE16(b + 8);
+    return w > 0 && h > 0;
+}
+
+static bool ReadBmp(std::ifstream& f, int& w, int& h) {
+    // 14-byte file header, then the DIB header: 16-bit sizes in the old
+    // OS/2 core header, signed 32-bit (negative height = top-down) otherwise.
+    uint8_t b[26];
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(b), sizeof(b))) return false;
+    if (LE32(b + 14) == 12) {
+        w = (int)LE16(b + 18);
+        h = (int)LE16(b + 20);
+    } else {
+        w = (int32_t)LE32(b + 18);
+        h = (int32_t)LE32(b + 22);
+        if (h < 0) h = -h;
+    }
+    return w > 0 && h > 0;
+}
+
+bool ReadImageSize(const std::string& path, int& w, int& h) {
+    w = h = 0;
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    uint8_t sig[8];
+    if (!f.read(reinterpret_cast<char*>(sig), sizeof(sig))) return false;
+    if (sig[0] == 0x89 && sig[1] == 'P' && sig[2] == 'N' && sig[3] == 'G') return ReadPng(f, w, h);
+    if (sig[0] == 0xFF && sig[1] == 0xD8) return ReadJpeg(f, w, h);
+    if (sig[0] == 'G' && sig[1] == 'I' && sig[2] == 'F' && sig[3] == '8') return ReadGif(f, w, h);
+    if (sig[0] == 'B' && sig[1] == 'M') return ReadBmp(f, w, h);
+    return false;
+}
@@ -0,0 +1,18 @@
+// ============================================================================
+// IMAGE_INFO.HPP - Q-SHELL v3.0
+// Reads image dimensions from file headers without decoding.
+//
+// PNG: the IHDR chunk at a fixed offset. JPEG: walks the marker segments to
+// the first SOFn frame header, seeking over each one, so however large the
+// EXIF block it costs a few small reads. GIF / BMP: fixed header fields, so
+// every format the art picker offers can be filed in the art store. Used to
+// pick the artwork variant whose aspect best fits a card before anything is
+// handed to WIC.
+// ============================================================================
+
+#pragma once
+
+#include <string>
+
+// False if the file is not a PNG/JPEG/GIF/BMP or its header is out of range.
+bool ReadImageSize(const std::string& path, int& w, int& h);
@@ -0,0 +1,147 @@
+// ============================================================================
+// JSON_READER.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "json_reader.hpp"
+
+#include <cstring>
+
+// ─── Tokens ──────────────────────────────────────────────────────────────────
+
+JsonToken JsonReader::Next() {
+    for (;;) {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n')) m_p++;
+        if (m_p >= m_end) return m_stack.empty() ? JsonToken::End : JsonToken::Error;
+
+        char c = *m_p;
+        switch (c) {
+        case ',': m_p++; m_expectKey = !m_stack.empty() && m_stack.back() == 'o'; continue;
+        case ':': m_p++; m_expectKey = false; continue;
+
+        case '{': m_p++; m_stack.push_back('o'); m_expectKey = true;  return JsonToken::ObjectBegin;
+        case '[': m_p++; m_stack.push_back('a'); m_expectKey = false; return JsonToken::ArrayBegin;
+        case '}':
+        case ']': {
+            char want = (c == '}') ? 'o' : 'a';
+            if (m_stack.empty() || m_stack.back() != want) return JsonToken::Error;
+            m_p++; m_stack.pop_back(); m_expectKey = false;
+            return c == '}' ? JsonToken::ObjectEnd : JsonToken::ArrayEnd;
+        }
+
+        case '"': {
+            const char* s = ++m_p;
+            m_escaped = false;
+            while (m_p < m_end && *m_p != '"') {
+                if (*m_p == '\\') { m_escaped = true; m_p += 2; continue; }
+                m_p++;
+            }
+            if (m_p >= m_end) return JsonToken::Error;
+            m_raw = std::string_view(s, (size_t)(m_p - s));
+            m_p++;
+            if (m_expectKey) { m_expectKey = false; return JsonToken::Key; }
+            return JsonToken::String;
+        }
+
+        case 't': case 'f': case 'n': {
+            const char* lit = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+            size_t      n   = strlen(lit);
+            if ((size_t)(m_end - m_p) < n || memcmp(m_p, lit, n) != 0) return JsonToken::Error;
+            m_raw = std::string_view(m_p, n);
+            m_p += n;
+            return c == 't' ? JsonToken::True : c == 'f' ? JsonToken::False : JsonToken::Null;
+        }
+
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                const char* s = m_p;
+                while (m_p < m_end && ((*m_p >= '0' && *m_p <= '9') || *m_p == '.' || *m_p == '-' ||
+                                       *m_p == '+' || *m_p == 'e' || *m_p == 'E')) m_p++;
+                m_raw = std::string_view(s, (size_t)(m_p - s));
+                return JsonToken::Number;
+            }
+            return JsonToken::Error;
+        }
+    }
+}
+
+bool JsonReader::SkipToEnd() {
+    int depth = Depth() - 1;
+    for (;;) {
+        JsonToken t = Next();
+        if (t == JsonToken::Error || t == JsonToken::End) return false;
+        if ((t == JsonToken::ObjectEnd || t == JsonToken::ArrayEnd) && Depth() == depth) return true;
+    }
+}
+
+bool JsonReader::Skip() {
+    JsonToken t = Next();
+    if (t == JsonToken::ObjectBegin || t == JsonToken::ArrayBegin) return SkipToEnd();
+    return t != JsonToken::Error && t != JsonToken::End;
+}
+
+std::string JsonReader::Text() const {
+    return m_escaped ? JsonUnescape(m_raw) : std::string(m_raw);
+}
+
+// ─── Unescape ────────────────────────────────────────────────────────────────
+
+static void AppendUtf8(std::string& out, unsigned cp) {
+    if (cp < 0x80)         out += (char)cp;
+    else if (cp < 0x800) { out += (char)(0xC0 | (cp >> 6));  out += (char)(0x80 | (cp & 0x3F)); }
+    else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+static bool Hex4(std::string_view s, size_t i, unsigned& v) {
+    if (i + 4 > s.size()) return false;
+    v = 0;
+    for (size_t k = i; k < i + 4; k++) {
+        char c = s[k];
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (unsigned)(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+std::string JsonUnescape(std::string_view raw) {
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) { out += c; continue; }
+        char e = raw[++i];
+        switch (e) {
+        case 'n': out += '\n'; break;
+        case 't': out += '\t'; break;
+        case 'r': out += '\r'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'u': {
+            unsigned cp;
+            if (!Hex4(raw, i + 1, cp)) { out += '?'; break; }
+            i += 4;
+            unsigned lo;
+            if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < raw.size() && raw[i + 1] == '\\' &&
+                raw[i + 2] == 'u' && Hex4(raw, i + 3, lo) && lo >= 0xDC00 && lo < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                i += 6;
+            }
+            AppendUtf8(out, cp);
+            break;
+        }
+        default: out += e; break;   // \" \\ \/
+        }
+    }
+    return out;
+}
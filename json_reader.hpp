@@ -0,0 +1,51 @@
+// ============================================================================
+// JSON_READER.HPP - Q-SHELL v3.0
+// Forward-only pull (SAX-style) JSON reader.
+//
+// Works in place on a caller-owned buffer: Next() advances one token and
+// Raw() is a string_view into the source, so a caller that wants three keys
+// from a large document reads tokens until it has them and stops - nothing
+// after that point is ever scanned. Strings are unescaped (including \uXXXX
+// and surrogate pairs) only when Text() is called. Layout-independent: the
+// same code handles pretty-printed and minified input.
+// ============================================================================
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class JsonToken {
+    Error, End,
+    ObjectBegin, ObjectEnd, ArrayBegin, ArrayEnd,
+    Key, String, Number, True, False, Null,
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : m_p(text.data()), m_end(text.data() + text.size()) {}
+
+    JsonToken Next();
+
+    std::string_view Raw()     const { return m_raw; }   // Key/String: between quotes; Number: literal
+    bool             Escaped() const { return m_escaped; }
+    std::string      Text()    const;                    // unescaped Key/String
+    int              Depth()   const { return (int)m_stack.size(); }
+
+    // Skips the value that follows the current Key (scalar or whole container).
+    bool Skip();
+    // Skips the rest of the container whose Begin token was just returned.
+    bool SkipToEnd();
+
+private:
+    const char*       m_p;
+    const char*       m_end;
+    std::string_view  m_raw;
+    bool              m_escaped   = false;
+    bool              m_expectKey = false;
+    std::vector<char> m_stack;   // 'o' / 'a' per open container
+};
+
+// Undoes JSON string escapes; \uXXXX (and surrogate pairs) become UTF-8.
+std::string JsonUnescape(std::string_view raw);
@@ -0,0 +1,162 @@
+// ============================================================================
+// LIBRARY_INDEX.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "library_index.hpp"
+
+#include <cstring>
+#include <unordered_set>
+
+// ─── Keys ────────────────────────────────────────────────────────────────────
+
+// 8-bytes-at-a-time multiply/rotate mix. Also the art store's content hash, so
+// changing it invalidates every art manifest as well as the in-memory keys.
+uint64_t LibraryIndex::HashBytes(const void* data, size_t n) {
+    const char*    p = static_cast<const char*>(data);
+    const uint64_t K = 0x9E3779B97F4A7C15ull;
+    uint64_t h = 0xcbf29ce484222325ull ^ (n * K);
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ (w * K)) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+    uint64_t t = 0;
+    memcpy(&t, p, n);
+    h = (h ^ (t * K)) * 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    return h ? h : 1;
+}
+
+// Hashes the path as if it had been lower-cased, '/' -> '\', repeated
+// separators collapsed (a leading "\\" UNC prefix is kept) and "\.\"
+// segments dropped. Normalises into a stack buffer, so typical paths cost no
+// allocation.
+uint64_t LibraryIndex::ExeKey(std::string_view exePath) {
+    if (exePath.empty()) return 0;
+    char        local[512];
+    std::string heap;
+    char*       buf = local;
+    if (exePath.size() > sizeof(local)) { heap.resize(exePath.size()); buf = &heap[0]; }
+
+    size_t n = 0;
+    for (char c : exePath) {
+        char ch = (c == '/') ? '\\' : (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+        if (ch == '\\' && n > 1 && buf[n - 1] == '\\') continue;                   // "a\\b" -> "a\b"
+        if (ch == '\\' && n >= 2 && buf[n - 1] == '.' && buf[n - 2] == '\\') {  // "\.\" -> "\"
+            n--;
+            continue;
+        }
+        buf[n++] = ch;
+    }
+    return HashBytes(buf, n);
+}
+
+uint64_t LibraryIndex::IdKey(const GameInfo& g) {
+    if (g.appId.empty() || g.platform.empty() || g.platform == "Manual") return 0;
+    char buf[256];
+    size_t n = g.platform.size() + 1 + g.appId.size();
+    if (n > sizeof(buf)) return HashBytes((g.platform + '\x1f' + g.appId).data(), n);
+    memcpy(buf, g.platform.data(), g.platform.size());
+    buf[g.platform.size()] = '\x1f';
+    memcpy(buf + g.platform.size() + 1, g.appId.data(), g.appId.size());
+    return HashBytes(buf, n);
+}
+
+// ─── Maintenance ─────────────────────────────────────────────────────────────
+
+void LibraryIndex::Clear() {
+    m_slots.clear(); m_byExe.clear(); m_byId.clear();
+}
+
+void LibraryIndex::Reserve(size_t n) {
+    m_slots.reserve(n); m_byExe.reserve(n); m_byId.reserve(n);
+}
+
+void LibraryIndex::Insert(const GameInfo& g, size_t idx) {
+    Slot s;
+    s.exeKey = ExeKey(g.exePath);
+    s.idKey  = IdKey(g);
+    s.store  = s.idKey != 0;
+    if (idx >= m_slots.size()) m_slots.resize(idx + 1);
+    // First writer wins, matching Find(): a later duplicate never shadows the
+    // entry the user already has.
+    if (s.exeKey) m_byExe.emplace(s.exeKey, idx);
+    if (s.idKey)  m_byId.emplace(s.idKey, idx);
+    m_slots[idx] = std::move(s);
+}
+
+void LibraryIndex::Update(size_t idx, const GameInfo& g) {
+    if (idx >= m_slots.size()) return;
+    Slot& s = m_slots[idx];
+    auto dropIfOurs = [idx](std::unordered_map<uint64_t, size_t>& m, uint64_t k) {
+        auto it = m.find(k);
+        if (it != m.end() && it->second == idx) m.erase(it);
+    };
+    dropIfOurs(m_byExe, s.exeKey);
+    dropIfOurs(m_byId, s.idKey);
+    Insert(g, idx);
+}
+
+void LibraryIndex::Erase(size_t idx) {
+    if (idx >= m_slots.size()) return;
+    m_slots.erase(m_slots.begin() + idx);
+    Rebuild();   // positions after idx shifted; removals are rare enough
+}
+
+void LibraryIndex::Rebuild() {
+    m_byExe.clear(); m_byId.clear();
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].exeKey) m_byExe.emplace(m_slots[i].exeKey, i);
+        if (m_slots[i].idKey)  m_byId.emplace(m_slots[i].idKey, i);
+    }
+}
+
+// ─── Queries ─────────────────────────────────────────────────────────────────
+
+int LibraryIndex::Find(const GameInfo& g) const {
+    auto it = m_byExe.find(ExeKey(g.exePath));
+    if (it != m_byExe.end()) return (int)it->second;
+    uint64_t id = IdKey(g);
+    if (id) {
+        auto jt = m_byId.find(id);
+        if (jt != m_byId.end()) return (int)jt->second;
+    }
+    return -1;
+}
+
+LibraryMergeResult LibraryIndex::Merge(const std::vector<GameInfo>& scanned) const {
+    LibraryMergeResult r;
+    std::vector<char> seen(m_slots.size(), 0);
+    std::unordered_set<uint64_t> newKeys;   // de-dups the scan against itself
+    newKeys.reserve(scanned.size());
+
+    for (size_t j = 0; j < scanned.size(); j++) {
+        const GameInfo& g = scanned[j];
+        uint64_t exe = ExeKey(g.exePath), id = IdKey(g);
+
+        auto it = m_byExe.find(exe);
+        if (it != m_byExe.end()) {
+            if (seen[it->second]) r.duplicates++;
+            seen[it->second] = 1;
+            continue;
+        }
+        if (id) {
+            auto jt = m_byId.find(id);
+            if (jt != m_byId.end()) {
+                if (seen[jt->second]) { r.duplicates++; continue; }
+                seen[jt->second] = 1;
+                r.moved.push_back({ jt->second, j });
+                continue;
+            }
+        }
+        bool fresh = newKeys.insert(exe).second;
+        if (id) fresh = newKeys.insert(id).second && fresh;
+        if (fresh) r.added.push_back(j);
+        else       r.duplicates++;
+    }
+
+    for (size_t i = 0; i < m_slots.size(); i++)
+        if (m_slots[i].store && !seen[i]) r.vanished.push_back(i);
+    return r;
+}
@@ -0,0 +1,66 @@
+// ============================================================================
+// LIBRARY_INDEX.HPP - Q-SHELL v3.0
+// Hash index over the library for O(1) lookup and linear-time scan merges.
+//
+// Every entry is keyed twice: by its normalised exe path (case, slash and
+// "\.\" insensitive, so the same install reached through two stores or a
+// hand-added entry collapses to one) and, for store games, by
+// (platform, appId), which is what still matches after a game is moved to
+// another drive. The index mirrors the library vector slot for slot; the
+// owner calls Insert / Update / Erase alongside each mutation.
+//
+// Keys are 64-bit hashes of the normalised form, built in a stack buffer, so
+// a lookup or a merge allocates nothing per entry. At library sizes (thousands) the chance
+// of a 64-bit collision is negligible.
+// ============================================================================
+
+#pragma once
+
+#include "game_finder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct LibraryMergeResult {
+    std::vector<size_t>                   added;       // scanned idx: not in the library
+    std::vector<std::pair<size_t,size_t>> moved;       // (library idx, scanned idx): same id, new exe
+    std::vector<size_t>                   vanished;    // library idx: store entry the scan didn't see
+    size_t                                duplicates = 0;   // scanned entries folded onto another
+};
+
+class LibraryIndex {
+public:
+    void Clear();
+    void Reserve(size_t n);
+
+    // Slot idx must equal the entry's position in the library vector.
+    void Insert(const GameInfo& g, size_t idx);
+    void Update(size_t idx, const GameInfo& g);
+    void Erase(size_t idx);   // shifts later slots down, like vector::erase
+
+    // Library position of the entry matching g (exe first, then id), or -1.
+    int Find(const GameInfo& g) const;
+
+    // Classifies a full scan against the current library in O(N + M).
+    LibraryMergeResult Merge(const std::vector<GameInfo>& scanned) const;
+
+    size_t Size() const { return m_slots.size(); }
+
+    static uint64_t ExeKey(std::string_view exePath);   // 0 for an empty path
+    static uint64_t IdKey(const GameInfo& g);           // 0 when there is no store id
+    static uint64_t HashBytes(const void* p, size_t n); // never 0; the raw hash behind both keys
+
+private:
+    struct Slot {
+        uint64_t exeKey = 0, idKey = 0;
+        bool     store  = false;   // has a store id (not "Manual")
+    };
+    void Rebuild();
+
+    std::vector<Slot>                    m_slots;
+    std::unordered_map<uint64_t, size_t> m_byExe;
+    std::unordered_map<uint64_t, size_t> m_byId;
+};
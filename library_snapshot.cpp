@@ -0,0 +1,97 @@
+// ============================================================================
+// LIBRARY_SNAPSHOT.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "library_snapshot.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+static const char SNAPSHOT_MAGIC[4] = { 'Q', 'L', 'I', 'B' };
+
+#pragma pack(push, 1)
+struct SnapshotHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t blobSize;
+    uint64_t fileSize;   // catches a truncated file before any record is read
+};
+struct SnapshotField { uint32_t off, len; };
+struct SnapshotRow   { SnapshotField name, exe, platform, appId; };
+#pragma pack(pop)
+
+static_assert(sizeof(SnapshotHeader) == 24, "snapshot header layout");
+static_assert(sizeof(SnapshotRow) == 32, "snapshot record layout");
+
+bool LibrarySnapshot::Open(const std::string& path) {
+    Close();
+    if (!m_file.Open(path) || m_file.Size() < sizeof(SnapshotHeader)) { Close(); return false; }
+
+    SnapshotHeader h;
+    memcpy(&h, m_file.Data(), sizeof(h));
+    uint64_t need = sizeof(h) + (uint64_t)h.count * sizeof(SnapshotRow) + h.blobSize;
+    if (memcmp(h.magic, SNAPSHOT_MAGIC, 4) != 0 || h.version != VERSION ||
+        h.fileSize != m_file.Size() || need != m_file.Size()) {
+        Close();
+        return false;
+    }
+
+    m_count   = h.count;
+    m_records = m_file.Data() + sizeof(h);
+    m_blob    = m_records + (size_t)h.count * sizeof(SnapshotRow);
+
+    // Validate every field once so Record() can hand out views unchecked.
+    for (size_t i = 0; i < m_count; i++) {
+        SnapshotRow r;
+        memcpy(&r, m_records + i * sizeof(SnapshotRow), sizeof(r));
+        for (const SnapshotField& f : { r.name, r.exe, r.platform, r.appId })
+            if ((uint64_t)f.off + f.len > h.blobSize) { Close(); return false; }
+    }
+    return true;
+}
+
+SnapshotRecord LibrarySnapshot::Record(size_t i) const {
+    SnapshotRow r;
+    memcpy(&r, m_records + i * sizeof(SnapshotRow), sizeof(r));
+    auto view = [this](const SnapshotField& f) { return std::string_view(m_blob + f.off, f.len); };
+    return { view(r.name), view(r.exe), view(r.platform), view(r.appId) };
+}
+
+bool LibrarySnapshot::Write(const std::string& path, const std::vector<GameInfo>& games) {
+    std::vector<SnapshotRow> rows(games.size());
+    std::string              blob;
+    auto put = [&blob](const std::string& s) {
+        SnapshotField f{ (uint32_t)blob.size(), (uint32_t)s.size() };
+        blob += s;
+        return f;
+    };
+    for (size_t i = 0; i < games.size(); i++) {
+        const GameInfo& g = games[i];
+        rows[i] = { put(g.name), put(g.exePath), put(g.platform), put(g.appId) };
+    }
+
+    SnapshotHeader h;
+    memcpy(h.magic, SNAPSHOT_MAGIC, 4);
+    h.version  = VERSION;
+    h.count    = (uint32_t)rows.size();
+    h.blobSize = (uint32_t)blob.size();
+    h.fileSize = sizeof(h) + rows.size() * sizeof(SnapshotRow) + blob.size();
+
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        f.write(reinterpret_cast<const char*>(rows.data()), (std::streamsize)(rows.size() * sizeof(SnapshotRow)));
+        f.write(blob.data(), (std::streamsize)blob.size());
+        if (!f) return false;
+    }
+    fs::rename(tmp, path, ec);
+    return !ec;
+}
@@ -0,0 +1,48 @@
+// ============================================================================
+// LIBRARY_SNAPSHOT.HPP - Q-SHELL v3.0
+// Binary library snapshot (profile\library.bin).
+//
+// Layout, little-endian, written in one go and renamed into place:
+//   header   magic "QLIB", version, record count, blob size, total size
+//   records  count x { offset,length } for name / exe / platform / appId
+//   blob     the strings, back to back, no terminators
+//
+// The reader maps the file and hands out string_views into the mapping, so
+// loading the library is a bounds check per record plus the copies into
+// GameInfo - no tokenising, no per-field getline. profile\library.txt stays
+// as the human-editable import/export format.
+// ============================================================================
+
+#pragma once
+
+#include "game_finder.hpp"
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct SnapshotRecord {
+    std::string_view name, exePath, platform, appId;
+};
+
+class LibrarySnapshot {
+public:
+    // Maps and validates the file. False if missing, torn or another version.
+    bool Open(const std::string& path);
+    void Close() { m_file.Close(); m_count = 0; }
+
+    size_t         Count() const { return m_count; }
+    SnapshotRecord Record(size_t i) const;   // views die with Close()
+
+    static bool Write(const std::string& path, const std::vector<GameInfo>& games);
+
+    static const uint32_t VERSION = 1;
+
+private:
+    MappedFile  m_file;
+    size_t      m_count = 0;
+    const char* m_records = nullptr;
+    const char* m_blob    = nullptr;
+};
@@ -0,0 +1,198 @@
+// ============================================================================
+// LIBRARY_VIEWS.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "library_views.hpp"
+
+#include <algorithm>
+
+// ─── Keys ────────────────────────────────────────────────────────────────────
+
+std::string LibraryViews::CollationKey(std::string_view name) {
+    std::string out;
+    out.reserve(name.size() + 8);
+    size_t i = 0;
+    if (name.size() > 4 && (name[0] == 'T' || name[0] == 't') && (name[1] == 'H' || name[1] == 'h') &&
+        (name[2] == 'E' || name[2] == 'e') && name[3] == ' ')
+        i = 4;
+    while (i < name.size()) {
+        unsigned char c = (unsigned char)name[i];
+        if (c >= '0' && c <= '9') {
+            // Digit runs compare by value: pad to a fixed width.
+            size_t j = i;
+            while (j < name.size() && name[j] >= '0' && name[j] <= '9') j++;
+            while (i < j - 1 && name[i] == '0') i++;
+            if (j - i < 10) out.append(10 - (j - i), '0');
+            out.append(name.data() + i, j - i);
+            i = j;
+            continue;
+        }
+        if (c >= 'A' && c <= 'Z')      out += (char)(c + 32);
+        else if (c >= 'a' && c <= 'z') out += (char)c;
+        else if (c >= 0x80)            out += (char)c;   // UTF-8 bytes sort after ASCII
+        else if (c == ' ' && !out.empty() && out.back() != ' ') out += ' ';
+        i++;
+    }
+    return out;
+}
+
+LibraryViews::Row LibraryViews::MakeRow(const ViewKeys& k) {
+    Row r;
+    r.collate = CollationKey(k.name);
+    r.platform.reserve(k.platform.size());
+    for (char c : k.platform) r.platform += (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+    r.lastPlayed = k.lastPlayed;
+    r.playtime   = k.playtime;
+    r.size       = k.size;
+    return r;
+}
+
+const char* LibraryViews::Name(LibraryView v) {
+    switch (v) {
+        case VIEW_DEFAULT:     return "Library Order";
+        case VIEW_NAME:        return "A-Z";
+        case VIEW_RECENT:      return "Recently Played";
+        case VIEW_MOST_PLAYED: return "Most Played";
+        case VIEW_PLATFORM:    return "By Platform";
+        case VIEW_ADDED:       return "Recently Added";
+        case VIEW_SIZE:        return "Largest First";
+        default:               return "";
+    }
+}
+
+// ─── Ordering ────────────────────────────────────────────────────────────────
+
+bool LibraryViews::Less(LibraryView v, uint32_t a, uint32_t b) const {
+    const Row& x = m_rows[a];
+    const Row& y = m_rows[b];
+    switch (v) {
+        case VIEW_NAME:
+            if (int c = x.collate.compare(y.collate)) return c < 0;
+            break;
+        case VIEW_RECENT:
+            if (x.lastPlayed != y.lastPlayed) return x.lastPlayed > y.lastPlayed;
+            if (x.collate != y.collate) return x.collate < y.collate;
+            break;
+        case VIEW_MOST_PLAYED:
+            if (x.playtime != y.playtime) return x.playtime > y.playtime;
+            if (x.collate != y.collate) return x.collate < y.collate;
+            break;
+        case VIEW_PLATFORM:
+            if (x.platform != y.platform) return x.platform < y.platform;
+            if (x.collate != y.collate) return x.collate < y.collate;
+            break;
+        case VIEW_SIZE:
+            if (x.size != y.size) return x.size > y.size;
+            if (x.collate != y.collate) return x.collate < y.collate;
+            break;
+        case VIEW_ADDED:
+            return a > b;
+        default:
+            break;
+    }
+    return a < b;
+}
+
+size_t LibraryViews::Find(LibraryView v, uint32_t pos) const {
+    const auto& o = m_order[v];
+    auto it = std::lower_bound(o.begin(), o.end(), pos,
+                               [&](uint32_t e, uint32_t p) { return Less(v, e, p); });
+    return (it != o.end() && *it == pos) ? (size_t)(it - o.begin()) : o.size();
+}
+
+void LibraryViews::Place(LibraryView v, uint32_t pos) {
+    auto& o = m_order[v];
+    auto it = std::upper_bound(o.begin(), o.end(), pos,
+                               [&](uint32_t p, uint32_t e) { return Less(v, p, e); });
+    o.insert(it, pos);
+}
+
+// ─── Maintenance ─────────────────────────────────────────────────────────────
+
+void LibraryViews::Clear() {
+    m_rows.clear();
+    for (auto& o : m_order) o.clear();
+}
+
+void LibraryViews::Reserve(size_t n) {
+    m_rows.reserve(n);
+    for (int v = VIEW_DEFAULT + 1; v < VIEW_COUNT; v++) m_order[v].reserve(n);
+}
+
+void LibraryViews::Append(const ViewKeys& k) {
+    uint32_t pos = (uint32_t)m_rows.size();
+    m_rows.push_back(MakeRow(k));
+    if (m_bulk) return;
+    for (int v = VIEW_DEFAULT + 1; v < VIEW_COUNT; v++) Place((LibraryView)v, pos);
+}
+
+void LibraryViews::EndBulk() {
+    m_bulk = false;
+    // One string sort: every other view is the name order stably re-sorted
+    // by its primary key, which yields exactly Less()'s tie-breaks.
+    auto& byName = m_order[VIEW_NAME];
+    byName.resize(m_rows.size());
+    for (size_t i = 0; i < byName.size(); i++) byName[i] = (uint32_t)i;
+    std::sort(byName.begin(), byName.end(), [&](uint32_t a, uint32_t b) { return Less(VIEW_NAME, a, b); });
+
+    m_order[VIEW_RECENT] = m_order[VIEW_MOST_PLAYED] = m_order[VIEW_PLATFORM] = m_order[VIEW_SIZE] = byName;
+    std::stable_sort(m_order[VIEW_RECENT].begin(), m_order[VIEW_RECENT].end(),
+                     [&](uint32_t a, uint32_t b) { return m_rows[a].lastPlayed > m_rows[b].lastPlayed; });
+    std::stable_sort(m_order[VIEW_MOST_PLAYED].begin(), m_order[VIEW_MOST_PLAYED].end(),
+                     [&](uint32_t a, uint32_t b) { return m_rows[a].playtime > m_rows[b].playtime; });
+    std::stable_sort(m_order[VIEW_PLATFORM].begin(), m_order[VIEW_PLATFORM].end(),
+                     [&](uint32_t a, uint32_t b) { return m_rows[a].platform < m_rows[b].platform; });
+    std::stable_sort(m_order[VIEW_SIZE].begin(), m_order[VIEW_SIZE].end(),
+                     [&](uint32_t a, uint32_t b) { return m_rows[a].size > m_rows[b].size; });
+
+    auto& added = m_order[VIEW_ADDED];
+    added.resize(m_rows.size());
+    for (size_t i = 0; i < added.size(); i++) added[i] = (uint32_t)(added.size() - 1 - i);
+}
+
+void LibraryViews::Update(size_t pos, const ViewKeys& k) {
+    if (pos >= m_rows.size()) return;
+    // Locate the entry under its old keys in every view before they change.
+    size_t at[VIEW_COUNT];
+    for (int v = VIEW_DEFAULT + 1; v < VIEW_COUNT; v++) at[v] = Find((LibraryView)v, (uint32_t)pos);
+    m_rows[pos] = MakeRow(k);
+
+    for (int v = VIEW_DEFAULT + 1; v < VIEW_COUNT; v++) {
+        auto&  o = m_order[v];
+        size_t i = at[v];
+        LibraryView lv = (LibraryView)v;
+        // Still between the same neighbours: nothing to move.
+        if (i < o.size() && (i == 0 || Less(lv, o[i - 1], (uint32_t)pos)) &&
+            (i + 1 == o.size() || Less(lv, (uint32_t)pos, o[i + 1])))
+            continue;
+        if (i < o.size()) o.erase(o.begin() + i);
+        Place(lv, (uint32_t)pos);
+    }
+}
+
+void LibraryViews::Erase(size_t pos) {
+    if (pos >= m_rows.size()) return;
+    for (int v = VIEW_DEFAULT + 1; v < VIEW_COUNT; v++) {
+        auto&  o = m_order[v];
+        size_t i = Find((LibraryView)v, (uint32_t)pos);
+        if (i < o.size()) o.erase(o.begin() + i);
+        // Later positions shift down by one; relative order is unchanged.
+        for (auto& p : o) if (p > pos) p--;
+    }
+    m_rows.erase(m_rows.begin() + pos);
+}
+
+// ─── Lookup ──────────────────────────────────────────────────────────────────
+
+int LibraryViews::At(LibraryView v, size_t row) const {
+    if (row >= m_rows.size()) return -1;
+    if (v == VIEW_DEFAULT || v >= VIEW_COUNT) return (int)row;
+    return (int)m_order[v][row];
+}
+
+int LibraryViews::RowOf(LibraryView v, size_t pos) const {
+    if (pos >= m_rows.size()) return -1;
+    if (v == VIEW_DEFAULT || v >= VIEW_COUNT) return (int)pos;
+    size_t i = Find(v, (uint32_t)pos);
+    return i < m_order[v].size() ? (int)i : -1;
+}
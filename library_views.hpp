@@ -0,0 +1,83 @@
+// ============================================================================
+// LIBRARY_VIEWS.HPP - Q-SHELL v3.0
+// Named sort orders over the library, kept as index permutations.
+//
+// Each view is a vector of library positions in display order. The owner
+// mirrors the library slot for slot (Append / Update / Erase, like
+// LibraryIndex) and each call moves only the affected entry: it is found by
+// binary search on its old keys and re-inserted at its new place, so a
+// change never re-sorts a view and never copies a library entry.
+//
+// Name order uses a collation key built once per entry: case-folded,
+// punctuation dropped, a leading "the " ignored and digit runs zero-padded,
+// so "Half-Life 2" sorts before "Half-Life 10". Ties in any view fall back to
+// library position, which keeps every order total and stable.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum LibraryView : uint8_t {
+    VIEW_DEFAULT,       // library order
+    VIEW_NAME,          // A-Z
+    VIEW_RECENT,        // last played, newest first
+    VIEW_MOST_PLAYED,   // playtime, most first
+    VIEW_PLATFORM,      // platform, then A-Z
+    VIEW_ADDED,         // newest entries first
+    VIEW_SIZE,          // installed size, largest first
+    VIEW_COUNT
+};
+
+struct ViewKeys {
+    std::string name;       // display name (collated here)
+    std::string platform;
+    long long   lastPlayed = 0;   // Unix seconds, 0 = never
+    long long   playtime   = 0;   // seconds
+    uint64_t    size       = 0;   // installed bytes, 0 = not known yet
+};
+
+class LibraryViews {
+public:
+    void Clear();
+    void Reserve(size_t n);
+
+    // Position must match the library vector: Append for a push_back,
+    // Erase shifts later positions down like vector::erase.
+    void Append(const ViewKeys& k);
+    void Update(size_t pos, const ViewKeys& k);
+    void Erase(size_t pos);
+
+    // Loading thousands of entries: Append only records keys between these,
+    // and EndBulk sorts each view once.
+    void BeginBulk() { m_bulk = true; }
+    void EndBulk();
+
+    size_t Size() const { return m_rows.size(); }
+
+    // Library position shown at row, and the row a position is shown at.
+    // Both -1 when out of range.
+    int At(LibraryView v, size_t row) const;
+    int RowOf(LibraryView v, size_t pos) const;
+
+    static const char*  Name(LibraryView v);
+    static std::string  CollationKey(std::string_view name);
+
+private:
+    struct Row {
+        std::string collate, platform;   // platform is case-folded
+        long long   lastPlayed = 0, playtime = 0;
+        uint64_t    size = 0;
+    };
+    static Row  MakeRow(const ViewKeys& k);
+    bool        Less(LibraryView v, uint32_t a, uint32_t b) const;
+    size_t      Find(LibraryView v, uint32_t pos) const;    // index into m_order[v]
+    void        Place(LibraryView v, uint32_t pos);         // binary-search insert
+
+    std::vector<Row>      m_rows;                 // by library position
+    std::vector<uint32_t> m_order[VIEW_COUNT];    // VIEW_DEFAULT unused: identity
+    bool                  m_bulk = false;
+};
@@ -0,0 +1,351 @@
+// ============================================================================
+// LIBRARY_WATCHER.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "library_watcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+// Steam rewrites an .acf several times in a row while it updates a game; wait
+// for this much quiet before re-resolving it.
+static const long long WATCH_DEBOUNCE_MS = 750;
+static const int       WATCH_POLL_MS     = 250;
+static const long long ROOT_RECHECK_MS   = 30000;
+
+static long long NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool IsManifestFile(const std::string& path) {
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".acf" || ext == ".item";
+}
+
+// Steam's list of library folders; a change can add or drop a whole root.
+static bool IsLibraryFoldersFile(const std::string& path) {
+    std::string name = fs::path(path).filename().string();
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name == "libraryfolders.vdf";
+}
+
+// ─── Lifecycle ───────────────────────────────────────────────────────────────
+
+void LibraryWatcher::Start(bool initialScan) {
+    Stop();
+    m_dirs.clear();
+    m_index.Clear();
+    m_dirty.clear();
+    m_rootsDirty = 0;
+    m_rootsChecked = NowMs();
+    m_stop     = false;
+    m_reroot   = false;
+    m_scanning = initialScan;
+    if (!initialScan) m_index.Load(SCAN_INDEX_FILE);
+    m_thread = std::thread(&LibraryWatcher::Run, this);
+}
+
+void LibraryWatcher::Stop() {
+    m_stop = true;
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void LibraryWatcher::Post(LibraryDelta d) {
+    std::lock_guard<std::mutex> l(m_mutex);
+    m_pending.push_back(std::move(d));
+}
+
+void LibraryWatcher::InitialScan() {
+    auto t0 = std::chrono::steady_clock::now();
+    std::atomic<long long> firstMs{ -1 };
+    std::atomic<int>       streamed{ 0 };
+
+    auto games = ScanInstalledGames([&](const GameInfo& g) {
+        long long none = -1;
+        firstMs.compare_exchange_strong(none, (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                  std::chrono::steady_clock::now() - t0).count());
+        streamed++;
+        Post({ LibraryDelta::ADD, "", g, {} });
+    }, m_stop);
+
+    m_index.Load(SCAN_INDEX_FILE);   // written by the scan just now
+    m_scanning = false;
+    if (m_stop) return;
+
+    LibraryDelta done;
+    done.kind     = LibraryDelta::SCAN_COMPLETE;
+    done.snapshot = std::move(games);
+    Post(std::move(done));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    DebugLog("[scan] streamed " + std::to_string(streamed.load()) + " games, first after " +
+             std::to_string(firstMs.load()) + " ms, complete in " + std::to_string((long long)ms) + " ms");
+}
+
+bool LibraryWatcher::Drain(std::vector<LibraryDelta>& out) {
+    std::lock_guard<std::mutex> l(m_mutex);
+    if (m_pending.empty()) return false;
+    for (auto& d : m_pending) out.push_back(std::move(d));
+    m_pending.clear();
+    return true;
+}
+
+// ─── Dirty set ───────────────────────────────────────────────────────────────
+
+void LibraryWatcher::MarkDirty(const std::string& path) {
+    if (IsManifestFile(path))            m_dirty[path] = NowMs();
+    else if (IsLibraryFoldersFile(path)) m_rootsDirty  = NowMs();
+}
+
+// Steam rewrites libraryfolders.vdf in bursts too, so it gets the same
+// debounce as a manifest.
+bool LibraryWatcher::RootsDue() {
+    long long now = NowMs();
+    bool due = m_reroot.exchange(false) ||
+               (m_rootsDirty && now - m_rootsDirty >= WATCH_DEBOUNCE_MS) ||
+               now - m_rootsChecked >= ROOT_RECHECK_MS;
+    if (due) { m_rootsDirty = 0; m_rootsChecked = now; }
+    return due;
+}
+
+void LibraryWatcher::MarkDirectoryDirty(const std::string& dir) {
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+        MarkDirty(it->path().string());
+    // Manifests we knew about in this folder may be the ones that vanished.
+    for (auto& [path, e] : m_index.Entries())
+        if (fs::path(path).parent_path() == fs::path(dir)) MarkDirty(path);
+}
+
+void LibraryWatcher::FlushDirty() {
+    if (m_dirty.empty()) return;
+    long long now = NowMs();
+
+    std::vector<std::string> ready;
+    for (auto it = m_dirty.begin(); it != m_dirty.end();) {
+        if (now - it->second >= WATCH_DEBOUNCE_MS) { ready.push_back(it->first); it = m_dirty.erase(it); }
+        else ++it;
+    }
+    if (ready.empty()) return;
+    std::sort(ready.begin(), ready.end());
+
+    std::vector<LibraryDelta> batch;
+    for (auto& m : ready) Resolve(m, batch);
+    if (batch.empty()) return;
+
+    m_index.Save(SCAN_INDEX_FILE);
+    DebugLog("[watch] " + std::to_string(ready.size()) + " manifest(s) changed, " +
+             std::to_string(batch.size()) + " delta(s) queued");
+
+    std::lock_guard<std::mutex> l(m_mutex);
+    for (auto& d : batch) m_pending.push_back(std::move(d));
+}
+
+void LibraryWatcher::Resolve(const std::string& manifest, std::vector<LibraryDelta>& out) {
+    auto known = m_index.Entries().find(manifest);
+    bool wasGame = known != m_index.Entries().end() && known->second.resolved;
+    GameInfo previous = wasGame ? known->second.game : GameInfo{};
+
+    std::error_code ec;
+    fs::directory_entry de(manifest, ec);
+    if (ec || !de.is_regular_file(ec)) {
+        if (wasGame) out.push_back({ LibraryDelta::REMOVE, manifest, previous, {} });
+        m_index.Erase(manifest);
+        return;
+    }
+
+    ScanIndexEntry e;
+    e.manifest = manifest;
+    e.size     = de.file_size(ec);
+    e.mtime    = (int64_t)de.last_write_time(ec).time_since_epoch().count();
+    if (m_index.Find(manifest, e.size, e.mtime)) return;   // touched but unchanged
+
+    e.resolved = ResolveManifest(manifest, e.game);
+    if (e.resolved) {
+        DownloadArt(e.game);
+        out.push_back({ wasGame ? LibraryDelta::UPDATE : LibraryDelta::ADD, manifest, e.game, previous });
+    } else if (wasGame) {
+        // Manifest still there but no longer resolves (e.g. exe gone mid-uninstall).
+        out.push_back({ LibraryDelta::REMOVE, manifest, previous, {} });
+    }
+    m_index.Put(std::move(e));
+}
+
+// ─── Watch loop ──────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+void LibraryWatcher::Run() {
+    struct Watch {
+        std::string path;
+        HANDLE      dir = INVALID_HANDLE_VALUE;
+        OVERLAPPED  ov  = {};
+        alignas(DWORD) BYTE buf[16384];
+    };
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+    std::vector<std::unique_ptr<Watch>> watches;
+    std::vector<HANDLE>                 events;
+    auto arm = [&](Watch& w) {
+        return ReadDirectoryChangesW(w.dir, w.buf, sizeof(w.buf), FALSE, filter, nullptr, &w.ov, nullptr) != 0;
+    };
+    auto open = [&](const std::string& d) {
+        auto w  = std::make_unique<Watch>();
+        w->path = d;
+        w->dir  = CreateFileA(d.c_str(), FILE_LIST_DIRECTORY,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (w->dir == INVALID_HANDLE_VALUE) return false;
+        w->ov.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        if (!w->ov.hEvent || !arm(*w)) {
+            if (w->ov.hEvent) CloseHandle(w->ov.hEvent);
+            CloseHandle(w->dir);
+            return false;
+        }
+        watches.push_back(std::move(w));
+        return true;
+    };
+    auto close = [](Watch& w) {
+        DWORD bytes = 0;
+        CancelIo(w.dir);
+        GetOverlappedResult(w.dir, &w.ov, &bytes, TRUE);   // buf stays ours until the cancel lands
+        CloseHandle(w.ov.hEvent);
+        CloseHandle(w.dir);
+    };
+    // Brings the watch set in line with dirs. Folders that join later are
+    // walked once, so games already in them are picked up.
+    auto sync = [&](const std::vector<std::string>& dirs, bool joined) {
+        for (auto it = watches.begin(); it != watches.end();) {
+            if (std::find(dirs.begin(), dirs.end(), (*it)->path) == dirs.end()) { close(**it); it = watches.erase(it); }
+            else ++it;
+        }
+        for (auto& d : dirs) {
+            bool have = std::any_of(watches.begin(), watches.end(), [&](auto& w) { return w->path == d; });
+            if (have || watches.size() == MAXIMUM_WAIT_OBJECTS || !open(d)) continue;
+            if (joined) MarkDirectoryDirty(d);
+        }
+        events.clear();
+        for (auto& w : watches) events.push_back(w->ov.hEvent);
+        m_dirs     = dirs;
+        m_dirCount = watches.size();
+    };
+
+    sync(GetManifestDirectories(), false);
+    DebugLog("[watch] watching " + std::to_string(watches.size()) + " manifest folder(s)");
+    if (m_scanning) InitialScan();
+
+    while (!m_stop) {
+        DWORD r = events.empty() ? WAIT_TIMEOUT
+                                 : WaitForMultipleObjects((DWORD)events.size(), events.data(), FALSE, WATCH_POLL_MS);
+        if (events.empty()) Sleep(WATCH_POLL_MS);
+
+        if (r >= WAIT_OBJECT_0 && r < WAIT_OBJECT_0 + events.size()) {
+            Watch& w = *watches[r - WAIT_OBJECT_0];
+            DWORD bytes = 0;
+            if (GetOverlappedResult(w.dir, &w.ov, &bytes, FALSE) && bytes > 0) {
+                for (BYTE* p = w.buf;;) {
+                    auto* fni = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(p);
+                    int n = WideCharToMultiByte(CP_UTF8, 0, fni->FileName, (int)(fni->FileNameLength / sizeof(WCHAR)),
+                                                nullptr, 0, nullptr, nullptr);
+                    std::string name(n, '\0');
+                    WideCharToMultiByte(CP_UTF8, 0, fni->FileName, (int)(fni->FileNameLength / sizeof(WCHAR)),
+                                        &name[0], n, nullptr, nullptr);
+                    MarkDirty(w.path + "\\" + name);
+                    if (!fni->NextEntryOffset) break;
+                    p += fni->NextEntryOffset;
+                }
+            } else {
+                // Zero bytes = the kernel buffer overflowed; we no longer know
+                // what changed, so re-check the whole folder.
+                MarkDirectoryDirty(w.path);
+            }
+            ResetEvent(w.ov.hEvent);
+            arm(w);
+        }
+        FlushDirty();
+        if (RootsDue()) {
+            auto dirs = GetManifestDirectories();
+            if (dirs != m_dirs) {
+                sync(dirs, true);
+                DebugLog("[watch] library folders changed, watching " + std::to_string(watches.size()));
+            }
+        }
+    }
+
+    for (auto& w : watches) close(*w);
+}
+
+#else
+
+void LibraryWatcher::Run() {
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    std::unordered_map<int, std::string> wds;
+    auto sync = [&](const std::vector<std::string>& dirs, bool joined) {
+        if (fd < 0) return;
+        for (auto it = wds.begin(); it != wds.end();) {
+            if (std::find(dirs.begin(), dirs.end(), it->second) == dirs.end()) { inotify_rm_watch(fd, it->first); it = wds.erase(it); }
+            else ++it;
+        }
+        for (auto& d : dirs) {
+            bool have = std::any_of(wds.begin(), wds.end(), [&](auto& w) { return w.second == d; });
+            if (have) continue;
+            int wd = inotify_add_watch(fd, d.c_str(), IN_CREATE | IN_CLOSE_WRITE | IN_MODIFY |
+                                                      IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE);
+            if (wd < 0) continue;
+            wds[wd] = d;
+            if (joined) MarkDirectoryDirty(d);
+        }
+        m_dirs     = dirs;
+        m_dirCount = wds.size();
+    };
+    sync(GetManifestDirectories(), false);
+    DebugLog("[watch] watching " + std::to_string(wds.size()) + " manifest folder(s)");
+    if (m_scanning) InitialScan();
+
+    alignas(inotify_event) char buf[16384];
+    while (!m_stop) {
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (fd >= 0 && poll(&pfd, 1, WATCH_POLL_MS) > 0) {
+            ssize_t len;
+            while ((len = read(fd, buf, sizeof(buf))) > 0) {
+                for (char* p = buf; p < buf + len;) {
+                    auto* ev = reinterpret_cast<inotify_event*>(p);
+                    auto it = wds.find(ev->wd);
+                    if (ev->mask & IN_Q_OVERFLOW) for (auto& [wd, d] : wds) MarkDirectoryDirty(d);
+                    else if (it != wds.end() && ev->len) MarkDirty(it->second + "/" + ev->name);
+                    p += sizeof(inotify_event) + ev->len;
+                }
+            }
+        } else if (fd < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_POLL_MS));
+        }
+        FlushDirty();
+        if (RootsDue()) {
+            auto dirs = GetManifestDirectories();
+            if (dirs != m_dirs) {
+                sync(dirs, true);
+                DebugLog("[watch] library folders changed, watching " + std::to_string(wds.size()));
+            }
+        }
+    }
+    if (fd >= 0) close(fd);
+}
+
+#endif
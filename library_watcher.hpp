@@ -0,0 +1,95 @@
+// ============================================================================
+// LIBRARY_WATCHER.HPP - Q-SHELL v3.0
+// Background watcher for store manifest folders.
+//
+// Watches every Steam library's steamapps folder and Epic's Manifests folder
+// (ReadDirectoryChangesW on Windows, inotify elsewhere). Changed manifests
+// are debounced, re-resolved on the watcher thread and turned into
+// add / update / remove deltas. The UI thread drains the deltas once per
+// frame and applies them to the library, so the library never needs a
+// manual full rescan.
+//
+// The startup scan runs on the same thread and feeds the same queue: each
+// game is posted as an ADD the moment it resolves, followed by one
+// SCAN_COMPLETE. Watches are armed before the scan starts, so nothing that
+// changes mid-scan is lost.
+//
+// The folder set is re-read when libraryfolders.vdf changes, on Reroot(),
+// and every half minute (Epic's Manifests folder may only appear later).
+// Folders that join are watched and their manifests resolved as ADDs.
+// ============================================================================
+
+#pragma once
+
+#include "game_finder.hpp"
+#include "scan_index.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct LibraryDelta {
+    enum Kind { ADD, UPDATE, REMOVE, SCAN_COMPLETE };
+    Kind        kind = ADD;
+    std::string manifest = {};
+    GameInfo    game     = {};   // ADD/UPDATE: new state. REMOVE: last known state.
+    GameInfo    previous = {};   // UPDATE: last known state
+    std::vector<GameInfo> snapshot = {};   // SCAN_COMPLETE: the full scan, for the merge
+};
+
+class LibraryWatcher {
+public:
+    LibraryWatcher() = default;
+    ~LibraryWatcher() { Stop(); }
+    LibraryWatcher(const LibraryWatcher&)            = delete;
+    LibraryWatcher& operator=(const LibraryWatcher&) = delete;
+
+    // Starts the watcher thread on GetManifestDirectories(). With
+    // initialScan, a streaming full scan runs first; either way the known
+    // manifest -> game map is then seeded from the scan index. Stop()
+    // cancels a scan that is still running.
+    void Start(bool initialScan);
+    void Stop();
+
+    // Re-reads the folder set on the watcher thread's next pass.
+    void Reroot() { m_reroot = true; }
+
+    bool IsScanning() const { return m_scanning; }
+
+    // UI thread: moves every queued delta into out. False if there were none.
+    bool Drain(std::vector<LibraryDelta>& out);
+
+    size_t DirectoryCount() const { return m_dirCount; }
+
+private:
+    void Run();
+    void InitialScan();
+    void Post(LibraryDelta d);
+    void MarkDirty(const std::string& path);
+    void MarkDirectoryDirty(const std::string& dir);   // after a buffer overflow, or a new folder
+    void FlushDirty();
+    void Resolve(const std::string& manifest, std::vector<LibraryDelta>& out);
+    bool RootsDue();
+
+    std::thread              m_thread;
+    std::atomic<bool>        m_stop{ false };
+    std::atomic<bool>        m_scanning{ false };
+    std::atomic<bool>        m_reroot{ false };
+    std::atomic<size_t>      m_dirCount{ 0 };   // folders actually watched
+
+    // Watcher thread only.
+    std::vector<std::string>                   m_dirs;
+    long long                                  m_rootsDirty   = 0;   // libraryfolders.vdf event (ms)
+    long long                                  m_rootsChecked = 0;
+    ScanIndex                                  m_index;
+    std::unordered_map<std::string, long long> m_dirty;   // manifest -> last event (ms)
+
+    std::mutex                m_mutex;
+    std::vector<LibraryDelta> m_pending;
+};
+
+// Manifest extensions the watcher reacts to.
+bool IsManifestFile(const std::string& path);
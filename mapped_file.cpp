@@ -0,0 +1,39 @@
+// ============================================================================
+// MAPPED_FILE.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "mapped_file.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    // FILE_SHARE_WRITE|DELETE: Steam rewrites these files while it runs, and
+    // we must never be the reason its write fails.
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    m_file = f;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { Close(); return false; }
+    m_size = (size_t)sz.QuadPart;
+    if (m_size == 0) return true;   // CreateFileMapping rejects empty files
+
+    m_mapping = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) { Close(); return false; }
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) { Close(); return false; }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data)    UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file)    CloseHandle(m_file);
+    m_data = nullptr; m_mapping = nullptr; m_file = nullptr; m_size = 0;
+}
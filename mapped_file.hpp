@@ -0,0 +1,36 @@
+// ============================================================================
+// MAPPED_FILE.HPP - Q-SHELL v3.0
+// Read-only memory-mapped file.
+//
+// Used by the text parsers (VDF, JSON) so a multi-megabyte config file is
+// viewed in place instead of being copied line by line into std::strings.
+// The view stays valid until Close() or destruction.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool             IsOpen() const { return m_file != nullptr; }
+    const char*      Data()   const { return m_data; }
+    size_t           Size()   const { return m_size; }
+    std::string_view View()   const { return { m_data ? m_data : "", m_size }; }
+
+private:
+    void*       m_file    = nullptr;   // HANDLE
+    void*       m_mapping = nullptr;   // HANDLE, null for empty files
+    const char* m_data    = nullptr;
+    size_t      m_size    = 0;
+};
@@ -0,0 +1,174 @@
+// ============================================================================
+// PE_READER.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "pe_reader.hpp"
+
+#include <fstream>
+#include <vector>
+
+static const size_t PE_HEADER_READ   = 4096;
+static const size_t PE_RSRC_DIR_READ = 8192;    // resource directory tables
+static const size_t PE_VERSION_MAX   = 16384;   // VS_VERSION_INFO blob
+
+// ─── Little-endian helpers (bounds-checked) ──────────────────────────────────
+
+static inline bool In(const std::vector<uint8_t>& b, size_t off, size_t n) {
+    return off <= b.size() && n <= b.size() - off;
+}
+static inline uint16_t U16(const std::vector<uint8_t>& b, size_t off) {
+    return In(b, off, 2) ? (uint16_t)(b[off] | (b[off + 1] << 8)) : 0;
+}
+static inline uint32_t U32(const std::vector<uint8_t>& b, size_t off) {
+    return In(b, off, 4) ? (uint32_t)b[off] | ((uint32_t)b[off + 1] << 8) |
+                           ((uint32_t)b[off + 2] << 16) | ((uint32_t)b[off + 3] << 24)
+                         : 0;
+}
+
+static bool ReadAt(std::ifstream& f, uint64_t off, size_t n, std::vector<uint8_t>& out) {
+    out.assign(n, 0);
+    f.clear();
+    f.seekg((std::streamoff)off);
+    if (!f) return false;
+    f.read(reinterpret_cast<char*>(out.data()), (std::streamsize)n);
+    out.resize((size_t)f.gcount());
+    return !out.empty();
+}
+
+// ─── Section mapping ─────────────────────────────────────────────────────────
+
+struct PESection { uint32_t va, vsize, rawOff, rawSize; };
+
+static bool RvaToOffset(const std::vector<PESection>& secs, uint32_t rva, uint64_t& off) {
+    for (auto& s : secs) {
+        uint32_t span = s.vsize ? s.vsize : s.rawSize;
+        if (rva >= s.va && rva < s.va + span) { off = (uint64_t)s.rawOff + (rva - s.va); return true; }
+    }
+    return false;
+}
+
+// ─── Version resource ────────────────────────────────────────────────────────
+// VS_VERSION_INFO is a tree of { WORD len, WORD valueLen, WORD type,
+// WCHAR key[], pad to 4, value } nodes. Rather than walk every StringTable we
+// look for the UTF-16 key directly; the String node header sits 6 bytes before
+// the key and its value follows the key's terminator, 4-byte aligned.
+
+static std::string ReadVersionString(const std::vector<uint8_t>& v, const char* key) {
+    size_t klen = 0;
+    while (key[klen]) klen++;
+    for (size_t i = 6; i + (klen + 1) * 2 <= v.size(); i += 2) {
+        bool match = true;
+        for (size_t k = 0; k <= klen && match; k++) {
+            uint16_t ch = U16(v, i + k * 2);
+            match = (k == klen) ? ch == 0 : ch == (uint8_t)key[k];
+        }
+        if (!match) continue;
+
+        uint16_t valueChars = U16(v, i - 4);
+        size_t   p          = (i + (klen + 1) * 2 + 3) & ~(size_t)3;
+        std::string out;
+        for (uint16_t c = 0; c < valueChars && In(v, p, 2); c++, p += 2) {
+            uint16_t ch = U16(v, p);
+            if (ch == 0) break;
+            // Encode BMP code points as UTF-8 (surrogates are passed through
+            // as '?', which is fine for the fuzzy comparison this feeds).
+            if (ch < 0x80)           out += (char)ch;
+            else if (ch < 0x800)   { out += (char)(0xC0 | (ch >> 6)); out += (char)(0x80 | (ch & 0x3F)); }
+            else if (ch >= 0xD800 && ch < 0xE000) out += '?';
+            else                   { out += (char)(0xE0 | (ch >> 12)); out += (char)(0x80 | ((ch >> 6) & 0x3F)); out += (char)(0x80 | (ch & 0x3F)); }
+        }
+        return out;
+    }
+    return "";
+}
+
+// Follows root -> RT_VERSION (16) -> first name -> first language -> data.
+static bool FindVersionResource(std::ifstream& f, const std::vector<PESection>& secs,
+                                uint64_t rsrcOff,
+                                uint64_t& dataOff, uint32_t& dataSize) {
+    std::vector<uint8_t> dir;
+    if (!ReadAt(f, rsrcOff, PE_RSRC_DIR_READ, dir)) return false;
+
+    auto entry = [&](uint32_t tableOff, bool byId, uint32_t id, uint32_t& child) -> bool {
+        uint16_t named = U16(dir, tableOff + 12), ids = U16(dir, tableOff + 14);
+        uint32_t first = byId ? named : 0, count = byId ? ids : (uint32_t)named + ids;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t e = tableOff + 16 + (first + i) * 8;
+            if (!In(dir, e, 8)) return false;
+            if (byId && U32(dir, e) != id) continue;
+            child = U32(dir, e + 4);
+            return true;
+        }
+        return false;
+    };
+
+    uint32_t lvl1, lvl2, lvl3;
+    if (!entry(0, true, 16, lvl1) || !(lvl1 & 0x80000000u)) return false;
+    if (!entry(lvl1 & 0x7FFFFFFFu, false, 0, lvl2) || !(lvl2 & 0x80000000u)) return false;
+    if (!entry(lvl2 & 0x7FFFFFFFu, false, 0, lvl3) || (lvl3 & 0x80000000u)) return false;
+
+    uint32_t dataRva = U32(dir, lvl3), size = U32(dir, lvl3 + 4);
+    if (!dataRva || !size) return false;
+    if (!RvaToOffset(secs, dataRva, dataOff)) return false;
+    dataSize = size < PE_VERSION_MAX ? size : (uint32_t)PE_VERSION_MAX;
+    return true;
+}
+
+// ─── Public entry point ──────────────────────────────────────────────────────
+
+bool ReadPEInfo(const std::string& path, PEInfo& out) {
+    out = PEInfo{};
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+
+    std::vector<uint8_t> h;
+    if (!ReadAt(f, 0, PE_HEADER_READ, h) || U16(h, 0) != 0x5A4D) return false;   // "MZ"
+
+    uint32_t pe = U32(h, 0x3C);
+    if (!In(h, pe, 24) || U32(h, pe) != 0x00004550) return false;              // "PE\0\0"
+
+    uint32_t coff    = pe + 4;
+    out.machine      = U16(h, coff);
+    uint16_t nSect   = U16(h, coff + 2);
+    uint16_t optSize = U16(h, coff + 16);
+    out.isDll        = (U16(h, coff + 18) & 0x2000) != 0;                      // IMAGE_FILE_DLL
+
+    uint32_t opt   = coff + 20;
+    uint16_t magic = U16(h, opt);
+    if (magic != 0x10B && magic != 0x20B) return false;
+    out.is64      = (magic == 0x20B);
+    out.subsystem = U16(h, opt + 68);
+    out.valid     = true;
+
+    // Data directory 2 = resources. Offset of the directory array differs
+    // between PE32 (96) and PE32+ (112).
+    uint32_t dd       = opt + (out.is64 ? 112 : 96);
+    uint32_t nDirs    = U32(h, dd - 4);
+    uint32_t rsrcRva  = nDirs > 2 ? U32(h, dd + 2 * 8) : 0;
+    if (!rsrcRva) return true;
+
+    uint32_t secTable = opt + optSize;
+    std::vector<uint8_t> secBuf;
+    const std::vector<uint8_t>* sb = &h;
+    if (!In(h, secTable, (size_t)nSect * 40)) {
+        if (!ReadAt(f, secTable, (size_t)nSect * 40, secBuf)) return true;
+        sb = &secBuf; secTable = 0;
+    }
+    std::vector<PESection> secs;
+    for (uint16_t i = 0; i < nSect; i++) {
+        uint32_t s = secTable + i * 40;
+        secs.push_back({ U32(*sb, s + 12), U32(*sb, s + 8), U32(*sb, s + 20), U32(*sb, s + 16) });
+    }
+
+    uint64_t rsrcOff;
+    if (!RvaToOffset(secs, rsrcRva, rsrcOff)) return true;
+
+    uint64_t verOff; uint32_t verSize;
+    if (!FindVersionResource(f, secs, rsrcOff, verOff, verSize)) return true;
+
+    std::vector<uint8_t> ver;
+    if (!ReadAt(f, verOff, verSize, ver)) return true;
+    out.productName     = ReadVersionString(ver, "ProductName");
+    out.fileDescription = ReadVersionString(ver, "FileDescription");
+    return true;
+}
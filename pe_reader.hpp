@@ -0,0 +1,40 @@
+// ============================================================================
+// PE_READER.HPP - Q-SHELL v3.0
+// Minimal, portable PE/COFF header reader.
+//
+// Reads only what the library scanner needs to rank candidate executables:
+// machine, subsystem, DLL flag and the version-resource ProductName /
+// FileDescription strings. Every read is a bounded seek+read (headers are
+// taken from the first 4 KB, the version resource is capped at 16 KB), so
+// the cost per candidate is independent of the file's size.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// IMAGE_FILE_MACHINE_* / IMAGE_SUBSYSTEM_* values, spelled out so this header
+// does not need <windows.h>.
+enum : uint16_t {
+    PE_MACHINE_I386  = 0x014C,
+    PE_MACHINE_AMD64 = 0x8664,
+    PE_MACHINE_ARM64 = 0xAA64,
+};
+enum : uint16_t {
+    PE_SUBSYSTEM_GUI     = 2,
+    PE_SUBSYSTEM_CONSOLE = 3,
+};
+
+struct PEInfo {
+    bool        valid     = false;
+    bool        isDll     = false;
+    bool        is64      = false;   // PE32+ optional header
+    uint16_t    machine   = 0;
+    uint16_t    subsystem = 0;
+    std::string productName;         // UTF-8, empty if no version resource
+    std::string fileDescription;
+};
+
+// Returns false (and out.valid == false) for anything that is not a PE image.
+bool ReadPEInfo(const std::string& path, PEInfo& out);
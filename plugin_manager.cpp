@@ -119,6 +119,12 @@ const LoadedPlugin* PluginManager::ActiveSkin_() const
     return (p.enabled && p.IsSkin()) ? &p : nullptr;
 }
 
+float PluginManager::PosterAspect() const
+{
+    auto* s = ActiveSkin_();
+    return (s && s->desc.posterAspect > 0) ? s->desc.posterAspect : 480.f / 270.f;
+}
+
 void PluginManager::SetActiveSkin(int idx)
 {
     m_activeSkin = (idx < 0 || idx >= (int)m_plugins.size()) ? -1 : idx;
@@ -72,6 +72,9 @@ public:
     bool UpdateAndDrawSkinPicker(int sw, int sh,
                                  bool confirm, bool cancel, bool up, bool down);
 
+    // Card aspect (w / h) of the active skin, or the host's 480x270.
+    float PosterAspect() const;
+
     int  ActiveSkinIndex() const { return m_activeSkin; }
     void SetActiveSkin(int idx);
 
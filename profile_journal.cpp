@@ -0,0 +1,220 @@
+// ============================================================================
+// PROFILE_JOURNAL.CPP - Q-SHELL v3.0
+//
+// File layout:
+//   "QJRN" u32 version
+//   records: u32 payloadLen, u8 type, u8 fieldCount, u16 0, u32 crc, payload
+//   payload: fieldCount x { u32 len, bytes }
+// The CRC covers type, fieldCount and the payload.
+// ============================================================================
+
+#include "profile_journal.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+static const char     JOURNAL_MAGIC[4] = { 'Q', 'J', 'R', 'N' };
+static const uint32_t JOURNAL_VERSION  = 1;
+static const size_t   JOURNAL_HEADER   = 8;
+static const size_t   RECORD_HEADER    = 12;
+static const uint32_t RECORD_MAX       = 16 * 1024 * 1024;   // sanity bound on a length field
+
+ProfileJournal& Journal() {
+    static ProfileJournal journal;
+    return journal;
+}
+
+// ─── CRC32 (IEEE, reflected) ─────────────────────────────────────────────────
+
+uint32_t Crc32(const void* data, size_t n, uint32_t crc) {
+    static uint32_t table[256];
+    static bool     init = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)init;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    while (n--) crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// ─── Encoding ────────────────────────────────────────────────────────────────
+
+static void PutU32(std::string& out, uint32_t v) {
+    char b[4] = { (char)v, (char)(v >> 8), (char)(v >> 16), (char)(v >> 24) };
+    out.append(b, 4);
+}
+static uint32_t GetU32(const char* p) {
+    const uint8_t* u = reinterpret_cast<const uint8_t*>(p);
+    return (uint32_t)u[0] | (uint32_t)u[1] << 8 | (uint32_t)u[2] << 16 | (uint32_t)u[3] << 24;
+}
+
+static void Encode(const JournalRecord& r, std::string& out) {
+    std::string payload;
+    for (auto& f : r.fields) { PutU32(payload, (uint32_t)f.size()); payload += f; }
+
+    char tf[2] = { (char)r.type, (char)r.fields.size() };
+    uint32_t crc = Crc32(payload.data(), payload.size(), Crc32(tf, 2));
+    PutU32(out, (uint32_t)payload.size());
+    out.append(tf, 2);
+    out.append(2, '\0');
+    PutU32(out, crc);
+    out += payload;
+}
+
+// ─── Replay ──────────────────────────────────────────────────────────────────
+
+size_t ProfileJournal::Replay(const std::string& path, const std::function<void(const JournalRecord&)>& apply) {
+    std::string data;
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return 0;
+        data.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    if (data.size() < JOURNAL_HEADER || memcmp(data.data(), JOURNAL_MAGIC, 4) != 0 ||
+        GetU32(data.data() + 4) != JOURNAL_VERSION) {
+        DebugLog("[journal] " + path + " unreadable, ignored");
+        return 0;
+    }
+
+    size_t off = JOURNAL_HEADER, applied = 0;
+    while (off + RECORD_HEADER <= data.size()) {
+        const char* h   = data.data() + off;
+        uint32_t    len = GetU32(h);
+        if (len > RECORD_MAX || off + RECORD_HEADER + len > data.size()) break;
+        const char* payload = h + RECORD_HEADER;
+        if (Crc32(payload, len, Crc32(h + 4, 2)) != GetU32(h + 8)) break;
+
+        JournalRecord r;
+        r.type = (JournalRecord::Type)(uint8_t)h[4];
+        size_t n = (uint8_t)h[5], p = 0;
+        bool   ok = true;
+        for (size_t i = 0; i < n && ok; i++) {
+            if (p + 4 > len) { ok = false; break; }
+            uint32_t fl = GetU32(payload + p);
+            p += 4;
+            if (fl > len - p) { ok = false; break; }
+            r.fields.emplace_back(payload + p, fl);
+            p += fl;
+        }
+        if (!ok) break;
+        apply(r);
+        applied++;
+        off += RECORD_HEADER + len;
+    }
+
+    if (off < data.size()) {
+        DebugLog("[journal] dropped " + std::to_string(data.size() - off) + " torn bytes after " +
+                 std::to_string(applied) + " records");
+        std::error_code ec;
+        fs::resize_file(path, off, ec);
+    }
+    m_size = off;
+    return applied;
+}
+
+// ─── Writer ──────────────────────────────────────────────────────────────────
+
+bool ProfileJournal::Open(const std::string& path) {
+    Close();
+    m_path = path;
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    uint64_t sz = fs::file_size(path, ec);
+    if (ec || sz < JOURNAL_HEADER) { if (!Reset()) return false; }
+    else m_size = sz;
+    m_wantCompact = m_size > JOURNAL_COMPACT_BYTES;
+
+    m_stop   = false;
+    m_thread = std::thread(&ProfileJournal::WriterLoop, this);
+    return true;
+}
+
+void ProfileJournal::Close() {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (!m_thread.joinable()) return;
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+void ProfileJournal::Append(JournalRecord r) {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_queue.push_back({ std::move(r), nullptr });
+    }
+    m_cv.notify_one();
+}
+
+void ProfileJournal::Compact(std::function<bool()> writeBase) {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        if (m_compactQueued) return;   // the queued one will see this state too
+        m_compactQueued = true;
+        m_queue.push_back({ {}, std::move(writeBase) });
+    }
+    m_cv.notify_one();
+}
+
+bool ProfileJournal::Reset() {
+    std::ofstream f(m_path, std::ios::binary | std::ios::trunc);
+    if (!f) return false;
+    std::string h(JOURNAL_MAGIC, 4);
+    PutU32(h, JOURNAL_VERSION);
+    f.write(h.data(), (std::streamsize)h.size());
+    m_size = JOURNAL_HEADER;
+    return (bool)f;
+}
+
+void ProfileJournal::WriterLoop() {
+    std::string batch;
+    for (;;) {
+        std::deque<Item> items;
+        {
+            std::unique_lock<std::mutex> l(m_mutex);
+            m_cv.wait(l, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;   // m_stop and nothing left
+            items.swap(m_queue);
+        }
+
+        // Records are appended in runs; a compaction job splits a run so the
+        // records before it land in the journal it is about to replace.
+        auto flush = [&] {
+            if (batch.empty()) return;
+            std::ofstream f(m_path, std::ios::binary | std::ios::app);
+            f.write(batch.data(), (std::streamsize)batch.size());
+            f.flush();
+            if (f) m_size += batch.size();
+            else   DebugLog("[journal] append failed");
+            if (m_size > JOURNAL_COMPACT_BYTES) m_wantCompact = true;
+            batch.clear();
+        };
+        for (auto& it : items) {
+            if (!it.compact) { Encode(it.record, batch); continue; }
+            flush();
+            {
+                std::lock_guard<std::mutex> l(m_mutex);
+                m_compactQueued = false;
+            }
+            bool ok = false;
+            try { ok = it.compact(); } catch (...) {}
+            // On failure the journal stays authoritative; the next append
+            // past the threshold asks again.
+            if (!(ok && Reset())) DebugLog("[journal] compaction failed, keeping journal");
+            m_wantCompact = false;
+        }
+        flush();
+    }
+}
@@ -0,0 +1,81 @@
+// ============================================================================
+// PROFILE_JOURNAL.HPP - Q-SHELL v3.0
+// Append-only change journal for the profile (profile\journal.bin).
+//
+// Every profile mutation - a game added or removed, new art, a settings
+// change - becomes one small record. The UI thread only enqueues; a writer
+// thread appends batches and flushes. Each record carries its length and a
+// CRC32, so a crash mid-append costs at most the record being written: on
+// startup the journal is replayed on top of the base files (library.bin,
+// config.txt, apps.txt, art manifest) up to the first torn or corrupt
+// record, and the tail is cut there.
+//
+// Once the journal passes JOURNAL_COMPACT_BYTES, WantsCompaction() goes true;
+// the owner then snapshots its state and hands Compact() a job that rewrites
+// the base files. The job runs on the writer thread in queue order and the
+// journal is truncated after it succeeds, so no record is lost or applied
+// twice.
+// ============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct JournalRecord {
+    enum Type : uint8_t { ADD = 1, REMOVE = 2, UPDATE_ART = 3, SETTINGS = 4 };
+    Type                     type = ADD;
+    std::vector<std::string> fields;
+    // ADD / REMOVE: name, exePath, platform, appId
+    // UPDATE_ART:   art key, content hash (hex), w, h, ext
+    // SETTINGS:     section ("config" / "apps"), its full text
+};
+
+class ProfileJournal {
+public:
+    ~ProfileJournal() { Close(); }
+
+    // Replays every intact record in order, truncating a torn tail. Call once
+    // before Open(). Returns the number of records applied.
+    size_t Replay(const std::string& path, const std::function<void(const JournalRecord&)>& apply);
+
+    bool Open(const std::string& path);   // starts the writer thread
+    void Close();                         // drains the queue, then joins
+
+    void Append(JournalRecord r);                  // UI thread: enqueue only
+    void Compact(std::function<bool()> writeBase); // ditto; see header comment
+
+    bool     WantsCompaction() const { return m_wantCompact; }
+    uint64_t Size() const            { return m_size; }
+
+    static const uint64_t JOURNAL_COMPACT_BYTES = 256 * 1024;
+
+private:
+    struct Item {
+        JournalRecord         record;
+        std::function<bool()> compact;   // set for a compaction job
+    };
+    void WriterLoop();
+    bool Reset();   // truncate to just the header
+
+    std::string             m_path;
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Item>        m_queue;
+    bool                    m_stop = false;
+    bool                    m_compactQueued = false;
+    std::atomic<bool>       m_wantCompact{ false };
+    std::atomic<uint64_t>   m_size{ 0 };
+};
+
+ProfileJournal& Journal();
+
+uint32_t Crc32(const void* data, size_t n, uint32_t crc = 0);
@@ -687,4 +687,5 @@ void RegisterPlugin(QShellPluginDesc* desc)
     desc->DrawGameCard     = DrawGameCard;
     desc->DrawSettingsTile = DrawSettingsTile;
     desc->DrawLibraryTab   = DrawLibraryTab;
+    desc->posterAspect     = 600.f / 900.f;   // portrait covers
 }
@@ -28,6 +28,25 @@
 //           qshell_plugin_api.h                   (updated — D2DPluginAPI)
 //           plugin_manager.hpp / .cpp             (updated)
 //           host_api.hpp                          (updated)
+//           task_pool.hpp / task_pool.cpp         (library scan workers)
+//           scan_index.hpp / scan_index.cpp       (incremental scan cache)
+//           pe_reader.hpp / pe_reader.cpp         (game exe scoring)
+//           mapped_file.hpp / mapped_file.cpp     (read-only file mapping)
+//           vdf_parser.hpp / vdf_parser.cpp       (Steam VDF/ACF reader)
+//           json_reader.hpp / json_reader.cpp     (Epic manifest reader)
+//           library_watcher.hpp / .cpp            (manifest folder watcher)
+//           library_index.hpp / .cpp              (library hash index + merge)
+//           art_fetcher.hpp / .cpp                (async poster downloads)
+//           image_info.hpp / .cpp                 (PNG/JPEG header sizes)
+//           art_store.hpp / .cpp                  (content-addressed posters)
+//           library_snapshot.hpp / .cpp           (binary library.bin)
+//           profile_journal.hpp / .cpp            (append-only profile journal)
+//           search_index.hpp / .cpp               (trigram type-to-search)
+//           library_views.hpp / .cpp              (sorted library views)
+//           session_tracker.hpp / .cpp            (play sessions / playtime)
+//           tag_index.hpp / .cpp                  (tags, collections, filters)
+//           dir_size_index.hpp / .cpp             (installed sizes)
+//           exe_fingerprint.hpp / .cpp            (move-aware exe fingerprints)
 // ============================================================================
 
 #define WIN32_LEAN_AND_MEAN
@@ -65,9 +84,24 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <cassert>
 
 #include "game_finder.hpp"
+#include "library_watcher.hpp"
+#include "library_index.hpp"
+#include "library_views.hpp"
+#include "tag_index.hpp"
+#include "art_fetcher.hpp"
+#include "art_store.hpp"
+#include "library_snapshot.hpp"
+#include "profile_journal.hpp"
+#include "session_tracker.hpp"
+#include "dir_size_index.hpp"
+#include "exe_fingerprint.hpp"
+#include "search_index.hpp"
 #include "system_control.hpp"
 #include "steam_integration.hpp"
 #include "desktop_apps.hpp"
@@ -187,7 +221,7 @@ enum { GAMEPAD_AXIS_LEFT_X=0, GAMEPAD_AXIS_LEFT_Y=1 };
 // ENUMS / CONSTANTS
 // ============================================================================
 
-enum class UIMode { MAIN, TASK_SWITCHER, SHELL_MENU, POWER_MENU, PROFILE_EDIT, THEME_SELECT, ACCOUNTS_VIEW, ADD_APP };
+enum class UIMode { MAIN, TASK_SWITCHER, SHELL_MENU, POWER_MENU, PROFILE_EDIT, THEME_SELECT, ACCOUNTS_VIEW, ADD_APP, SEARCH, FILTER, COLLECTIONS };
 enum class StartupChoice { NONE, NORMAL_APP, SHELL_MODE, EXIT_SHELL };
 enum class ShellAction   { NONE, EXPLORER, KEYBOARD, SETTINGS, TASKMGR, RESTART_SHELL, EXIT_SHELL, POWER };
 enum class PowerChoice   { NONE, RESTART, SHUTDOWN, SLEEP, CANCEL };
@@ -255,7 +289,43 @@ struct UIGame {
     GameInfo  info;
     D2DBitmap poster={};
     bool hasPoster=false;
-    float detailAlpha=0, selectAnim=0;
+    uint8_t  platform=PLATFORM_NONE;   // interned info.platform
+    uint64_t artKey=0, posterHash=0;   // art store key; content hash of the loaded poster
+    uint32_t uid=0;                    // stable id in the search index (slots shift, this doesn't)
+    long long lastPlayed=0, playtimeSec=0;   // Unix seconds; total seconds
+    std::string sizeRoot;              // install folder, DirSizeIndex::Key form
+    uint64_t sizeBytes=0;              // 0 until the first walk
+    ExeFingerprint print;              // last known; survives the exe going missing
+};
+
+// Card animation lives outside UIGame: only cards that are still moving are
+// listed, as dense parallel arrays, so a frame costs O(moving) rather than
+// O(library). A card that is not listed is settled at 0.
+struct CardAnim {
+    std::vector<int>   idx;
+    std::vector<float> alpha, target;
+    float Alpha(int i) const { for(size_t k=0;k<idx.size();k++)if(idx[k]==i)return alpha[k]; return 0; }
+    void Focus(int i){   // i animates toward 1, everything else toward 0; -1 = none
+        bool found=false;
+        for(size_t k=0;k<idx.size();k++){target[k]=(idx[k]==i)?1.f:0.f;found|=idx[k]==i;}
+        if(i>=0&&!found){idx.push_back(i);alpha.push_back(0);target.push_back(1);}
+    }
+    void Step(float k){
+        for(size_t j=0;j<idx.size();){
+            alpha[j]+=(target[j]-alpha[j])*k;
+            if(target[j]==0&&alpha[j]<0.005f){   // settled: swap-remove
+                idx[j]=idx.back();alpha[j]=alpha.back();target[j]=target.back();
+                idx.pop_back();alpha.pop_back();target.pop_back();
+            } else j++;
+        }
+    }
+    void OnErase(int i){   // library slot i went away; later slots shift down
+        for(size_t j=0;j<idx.size();){
+            if(idx[j]==i){idx[j]=idx.back();alpha[j]=alpha.back();target[j]=target.back();idx.pop_back();alpha.pop_back();target.pop_back();continue;}
+            if(idx[j]>i)idx[j]--;
+            j++;
+        }
+    }
 };
 
 struct UserProfile {
@@ -312,6 +382,7 @@ struct AppState {
     D2DBitmap   bgTexture={};
 
     std::vector<UIGame>             library;
+    CardAnim                        cardAnim;
     std::vector<RunningTask>        tasks;
     int   taskFocusIdx=0; float taskSlideIn=0, taskAnimTime=0;
     std::vector<Notification>       notifications;
@@ -321,8 +392,10 @@ struct AppState {
     std::thread inputThread;
     HHOOK kbHook=nullptr; DWORD lastTaskSwitchTime=0;
 
-    // Navigation
+    // Navigation. On the library tab, focused is a row of libraryView, not
+    // a library position (LibraryAt maps one to the other).
     int focused=0, barFocused=0;
+    int libraryView=VIEW_DEFAULT;
     bool inTopBar=false, showDetails=false, showDeleteWarning=false, isFullUninstall=false;
     float scrollY=0, transAlpha=0, holdTimer=0;
 
@@ -332,6 +405,15 @@ struct AppState {
     char addAppNameBuffer[64]={}, addAppPathBuffer[256]={};
     int addAppFocus=0; bool isAddingWebApp=false;
 
+    // Type-to-search overlay
+    std::string searchQuery;
+    std::vector<int> searchHits;   // library positions, best first
+    int searchFocus=0;
+
+    // Tag filter / collection overlays
+    std::string filterBuffer, collectionBuffer;
+    int tagFocus=0;
+
     // Settings
     int settingsFocusX=0, settingsFocusY=0;
 
@@ -372,6 +454,16 @@ static AppState g_app;
 // Plugin system — must come after AppState + g_app
 #include "qshell_plugin_api.h"
 #include "plugin_manager.hpp"
+void RemoveLibraryEntryAt(int idx);   // LIBRARY section; used by host_api
+int  SearchLibrary(const std::string& query,int limit,std::vector<int>& out);
+int  LibraryAt(int row);      // active view row -> library position, or -1
+int  LibraryRowOf(int pos);   // library position -> active view row, or -1 (also if filtered out)
+int  LibraryRowCount();       // games shown under the active filter
+void SetLibraryView(int view);
+void SetLibraryFilter(const std::string& expr);
+std::string LibraryFilterText();
+std::vector<std::string> LibraryTagsOf(int pos);
+void LaunchGame(int pos);     // WINDOW MANAGEMENT section; tracks the session
 #include "host_api.hpp"
 
 // ============================================================================
@@ -545,6 +637,16 @@ public:
     bool IsMenu(){ return IsKeyPressed(VK_TAB)||IsKeyPressed(VK_F1)||GPBtn(0x0010); }
     bool IsView(){ return IsKeyPressed(VK_F2)||GPBtn(0x0020); }
     bool IsBG()  { return IsKeyPressed('B'); }
+    bool IsSearch(){ return IsKeyPressed(VK_F3)||IsKeyPressed(VK_OEM_2); }   // F3 or '/'
+    bool IsSortCycle(){ return IsKeyPressed('V')||IsKeyPressed(VK_F4)||GPBtn(0x0080); }   // pad: right stick click
+    bool IsFilter()     { return IsKeyPressed('F')||GPBtn(0x0040); }   // pad: left stick click
+    bool IsCollections(){ return IsKeyPressed('C'); }
+    // Text-entry overlays: letters, space and backspace belong to the field.
+    bool IsTextUp()    { return IsKeyPressed(VK_UP)  ||Stick(GAMEPAD_AXIS_LEFT_Y,-STICK_DEADZONE)||GPBtn(0x0001); }
+    bool IsTextDown()  { return IsKeyPressed(VK_DOWN)||Stick(GAMEPAD_AXIS_LEFT_Y,STICK_DEADZONE) ||GPBtn(0x0002); }
+    bool IsTextConfirm(){ return IsKeyPressed(VK_RETURN)||GPBtn(0x1000); }
+    bool IsTextCancel() { return IsKeyPressed(VK_ESCAPE)||GPBtn(0x2000); }
+    bool IsTextRight()  { return IsKeyPressed(VK_RIGHT)||Stick(GAMEPAD_AXIS_LEFT_X,STICK_DEADZONE)||GPBtn(0x0008); }
     int  GetGamepadID(){ return gp_; }
 };
 
@@ -552,6 +654,7 @@ public:
 
 static void DrawSkinPickerOverlay(int sw,int sh,InputAdapter& input){
     PM().UpdateAndDrawSkinPicker(sw,sh,input.IsConfirm(),input.IsBack(),input.IsMoveUp(),input.IsMoveDown());
+    SetPreferredPosterAspect(PM().PosterAspect());
 }
 
 // ============================================================================
@@ -587,7 +690,7 @@ static const D2DPluginAPI g_d2dAPI = {
     sinf_wrap,
 };
 
-static void InitSkins(){ PM().Init(g_app.exeDir,&g_d2dAPI,&g_hostAPI); PM().LoadSkinChoice(); }
+static void InitSkins(){ PM().Init(g_app.exeDir,&g_d2dAPI,&g_hostAPI); PM().LoadSkinChoice(); SetPreferredPosterAspect(PM().PosterAspect()); }
 static void UnloadSkinPlugins(){ PM().Shutdown(); }
 
 // ============================================================================
@@ -676,42 +779,81 @@ void UpdateHubSlider(float dt){
 // PROFILE I/O
 // ============================================================================
 
-void SaveProfile(){
-    auto d=GetFullPath("profile");
-    try{fs::create_directories(d);fs::create_directories(GetFullPath("profile\\sounds"));}catch(...){}
-    auto& p=g_app.profile;
-    std::ofstream c(d+"\\config.txt");
-    if(c) c<<g_app.bgPath<<"\n"<<p.username<<"\n"<<p.avatarPath<<"\n"<<p.themeIndex<<"\n"
-           <<p.masterVolume<<"\n"<<p.musicVolume<<"\n"<<p.sfxVolume<<"\n"
-           <<(p.soundEnabled?1:0)<<"\n"<<(p.musicEnabled?1:0)<<"\n";
-    std::ofstream l(d+"\\library.txt");
-    if(l) for(auto& g:g_app.library)l<<g.info.name<<"|"<<g.info.exePath<<"|"<<g.info.platform<<"|"<<g.info.appId<<"\n";
-    std::ofstream a(d+"\\apps.txt");
-    if(a) for(auto& app:g_app.customApps){
+// Base files: config.txt, apps.txt, library.bin (+ library.txt export) and the
+// art manifest. Changes between rewrites go to profile\journal.bin; the UI
+// thread only ever enqueues (see profile_journal).
+static std::string ConfigText(){
+    auto& p=g_app.profile; std::ostringstream c;
+    c<<g_app.bgPath<<"\n"<<p.username<<"\n"<<p.avatarPath<<"\n"<<p.themeIndex<<"\n"
+     <<p.masterVolume<<"\n"<<p.musicVolume<<"\n"<<p.sfxVolume<<"\n"
+     <<(p.soundEnabled?1:0)<<"\n"<<(p.musicEnabled?1:0)<<"\n"<<g_app.libraryView<<"\n";
+    return c.str();
+}
+static std::string TagsText();   // LIBRARY
+static std::string AppsText(){
+    std::ostringstream a;
+    for(auto& app:g_app.customApps){
         int r2=(int)(app.accentColor.r*255),g2=(int)(app.accentColor.g*255),b2=(int)(app.accentColor.b*255);
         a<<app.name<<"|"<<app.path<<"|"<<app.iconPath<<"|"<<(app.isWebApp?1:0)<<"|"<<r2<<"|"<<g2<<"|"<<b2<<"\n";
     }
+    return a.str();
 }
 
-void LoadProfile(){
-    auto& p=g_app.profile; std::string path=GetFullPath("profile\\config.txt");
-    if(!fs::exists(path))return; std::ifstream c(path); if(!c)return;
+// Whole-file replace: a crash leaves either the old file or the new one.
+static bool WriteFileAtomic(const std::string& path,const std::string& text){
+    std::string tmp=path+".tmp";
+    {std::ofstream f(tmp,std::ios::binary|std::ios::trunc);f<<text;if(!f)return false;}
+    std::error_code ec; fs::rename(tmp,path,ec); if(ec)fs::remove(tmp,ec);
+    return !ec;
+}
+// Snapshots the profile here and rewrites the base files on the journal
+// thread, which then truncates the journal.
+void SaveProfile(){
+    auto d=GetFullPath("profile");
+    std::vector<GameInfo> lib; lib.reserve(g_app.library.size()); for(auto& g:g_app.library)lib.push_back(g.info);
+    Journal().Compact([d,lib=std::move(lib),cfg=ConfigText(),apps=AppsText(),tags=TagsText()]{
+        std::error_code ec; fs::create_directories(d+"\\sounds",ec);
+        bool ok=true;
+        ok&=WriteFileAtomic(d+"\\config.txt",cfg);
+        ok&=WriteFileAtomic(d+"\\apps.txt",apps);
+        ok&=WriteFileAtomic(d+"\\tags.txt",tags);
+        std::string bin=d+"\\library.bin",txt=d+"\\library.txt";
+        bool snap=LibrarySnapshot::Write(bin,lib); ok&=snap;
+        // Export copy, after the snapshot and stamped with its time: only a
+        // later hand edit makes the text newer (see LoadLibraryFromDisk).
+        if(snap){std::ostringstream l; for(auto& g:lib)l<<g.name<<"|"<<g.exePath<<"|"<<g.platform<<"|"<<g.appId<<"\n";
+            if(WriteFileAtomic(txt,l.str())){auto tb=fs::last_write_time(bin,ec);if(!ec)fs::last_write_time(txt,tb,ec);}}
+        ok&=Posters().Save();
+        return ok;
+    });
+}
+void JournalSettings(const std::string& section){
+    Journal().Append({JournalRecord::SETTINGS,{section,section=="apps"?AppsText():section=="tags"?TagsText():ConfigText()}});
+}
+
+static void ParseConfig(std::istream& c){
+    auto& p=g_app.profile;
     auto rl=[&](std::string& o)->bool{return!!std::getline(c,o);};
     auto rf=[&](float& o){std::string l;if(rl(l))try{o=std::stof(l);}catch(...){}};
     auto ri=[&](int& o){std::string l;if(rl(l))try{o=std::stoi(l);}catch(...){}};
     auto rb=[&](bool& o){std::string l;if(rl(l))o=(l=="1");};
     rl(g_app.bgPath);rl(p.username);rl(p.avatarPath);ri(p.themeIndex);
     rf(p.masterVolume);rf(p.musicVolume);rf(p.sfxVolume);rb(p.soundEnabled);rb(p.musicEnabled);
+    ri(g_app.libraryView); g_app.libraryView=Clamp(g_app.libraryView,0,VIEW_COUNT-1);
     if(p.username.empty())p.username="Player";
     g_audio.masterVolume=p.masterVolume;g_audio.musicVolume=p.musicVolume;g_audio.sfxVolume=p.sfxVolume;
     g_audio.soundEnabled=p.soundEnabled;g_audio.musicEnabled=p.musicEnabled;
     if(p.themeIndex>=0&&p.themeIndex<(int)ALL_THEMES.size())
         g_app.currentThemeIdx=p.themeIndex,g_app.theme=g_app.targetTheme=ALL_THEMES[p.themeIndex];
 }
+void LoadProfile(){
+    std::string path=GetFullPath("profile\\config.txt");
+    if(!fs::exists(path))return; std::ifstream c(path); if(!c)return;
+    ParseConfig(c);
+}
 
-void LoadCustomAppsFromProfile(){
-    std::string path=GetFullPath("profile\\apps.txt"); if(!fs::exists(path))return;
-    std::ifstream f(path); std::string line;
+static void ParseApps(std::istream& f){
+    g_app.customApps.clear(); std::string line;
     while(std::getline(f,line)){
         if(line.empty())continue; std::stringstream ss(line);
         std::string name,appPath,iconPath,isWeb,r2,g2,b2;
@@ -724,30 +866,485 @@ void LoadCustomAppsFromProfile(){
         }
     }
 }
+void LoadCustomAppsFromProfile(){
+    std::string path=GetFullPath("profile\\apps.txt"); if(!fs::exists(path))return;
+    std::ifstream f(path); ParseApps(f);
+}
 
 // ============================================================================
 // LIBRARY
 // ============================================================================
 
-void LoadLibraryFromDisk(){
-    std::string p=GetFullPath("profile\\library.txt"); if(!fs::exists(p))return;
+// Mirrors g_app.library slot for slot; kept in step by the helpers below.
+static LibraryIndex g_libIndex;
+static bool g_journalReplay=false;   // applying the journal: don't record it again, no D2D yet
+// Trigram index over name + platform, keyed by UIGame::uid and kept current
+// by the same helpers, so a search never needs a rebuild.
+static SearchIndex g_search;
+static uint32_t    g_nextUid=1;
+// uid -> library position, and install folder -> the uids installed there,
+// so a background completion reaches its entries without a library walk.
+static std::unordered_map<uint32_t,int> g_posOfUid;
+static std::unordered_map<std::string,std::vector<uint32_t>> g_uidsBySizeRoot;
+static int PositionOfUid(uint32_t u){ auto it=g_posOfUid.find(u); return it==g_posOfUid.end()?-1:it->second; }
+// Exe fingerprint hash -> uids, for the moved-install check in TryRebind.
+static std::unordered_map<uint64_t,std::vector<uint32_t>> g_uidsByPrint;
+static void SetPrint(UIGame& g,const ExeFingerprint& f){
+    if(g.print.Valid()){auto it=g_uidsByPrint.find(g.print.hash);
+        if(it!=g_uidsByPrint.end()){auto& v=it->second;v.erase(std::remove(v.begin(),v.end(),g.uid),v.end());if(v.empty())g_uidsByPrint.erase(it);}}
+    g.print=f; if(f.Valid())g_uidsByPrint[f.hash].push_back(g.uid);
+}
+static void UnlinkSizeRoot(const UIGame& g){
+    auto it=g_uidsBySizeRoot.find(g.sizeRoot); if(it==g_uidsBySizeRoot.end())return;
+    auto& v=it->second; v.erase(std::remove(v.begin(),v.end(),g.uid),v.end()); if(v.empty())g_uidsBySizeRoot.erase(it);
+}
+
+// Play stats share the art store's key (store id, else exe path), so they
+// follow a store game across drives like its poster does.
+static void ApplyPlayStats(UIGame& g){
+    PlayStats p; if(!Sessions().Find(g.artKey,p)){g.lastPlayed=g.playtimeSec=0;return;}
+    g.lastPlayed=p.lastPlayed; g.playtimeSec=p.playtime;
+}
+// Cached total right away; the walk (mostly stats against the cache) confirms it.
+static void ApplyInstallSize(UIGame& g,bool full=false){
+    UnlinkSizeRoot(g); g.sizeRoot=DirSizeIndex::Key(DirSizeIndex::InstallRoot(g.info.exePath)); g.sizeBytes=0;
+    if(g.sizeRoot.empty())return;
+    g_uidsBySizeRoot[g.sizeRoot].push_back(g.uid);
+    Sizes().Find(g.sizeRoot,g.sizeBytes); Sizes().Request(g.sizeRoot,full);
+}
+// Cached fingerprint right away; the request reports a changed or missing exe.
+static void ApplyFingerprint(UIGame& g){
+    ExeFingerprint f; Fingerprints().Find(g.info.exePath,f); SetPrint(g,f); Fingerprints().Request(g.info.exePath,g.uid);
+}
+static UIGame MakeUIGame(GameInfo gi){
+    UIGame g; g.platform=InternPlatform(gi.platform); g.artKey=ArtStore::KeyFor(gi); g.info=std::move(gi);
+    g.uid=g_nextUid++; g_search.Add(g.uid,g.info.name,g.info.platform); ApplyPlayStats(g); ApplyInstallSize(g); ApplyFingerprint(g);
+    return g;
+}
+// Sorted views of the library; mirrors it slot for slot like g_libIndex.
+static LibraryViews g_views;
+static ViewKeys KeysOf(const UIGame& g){ return {g.info.name,g.info.platform,g.lastPlayed,g.playtimeSec,g.sizeBytes}; }
+
+// Tags by library position: automatic ones (platform:, drive:, played:, size:)
+// derived from the entry, plus user collections, which are stored by game key
+// so they survive a rescan. The active filter narrows the view to g_rows.
+static TagIndex  g_tags;
+static TagFilter g_filter;
+static std::map<std::string,std::unordered_set<uint64_t>> g_collections;   // name -> game keys
+static int  g_tagMonth=-1;   // calendar month "played:month" refers to
+static std::vector<int> g_rows, g_rowOf;   // filtered: row -> position, position -> row or -1
+static bool g_rowsDirty=true;
+
+static void PlaceRow(size_t pos);
+static int MonthOf(long long t){ time_t tt=(time_t)t; struct tm* lt=localtime(&tt); return lt?(lt->tm_year+1900)*12+lt->tm_mon:-1; }
+static void AutoTag(size_t pos){
+    auto& G=g_app.library[pos]; uint32_t p=(uint32_t)pos;
+    for(auto pre:{"platform:","drive:","played:","size:"})g_tags.ClearPosition(p,pre);
+    g_tags.Set("platform:"+PlatformName(G.platform),p,true);
+    auto& e=G.info.exePath; if(e.size()>1&&e[1]==':')g_tags.Set(std::string("drive:")+e[0],p,true);
+    if(G.lastPlayed&&MonthOf(G.lastPlayed)==g_tagMonth)g_tags.Set("played:month",p,true);
+    if(G.sizeBytes){uint64_t gb=G.sizeBytes>>30; g_tags.Set(gb<1?"size:small":gb<10?"size:medium":gb<50?"size:large":"size:huge",p,true);}
+    for(auto& [name,keys]:g_collections)g_tags.Set(name,p,keys.count(G.artKey)>0);
+    PlaceRow(pos);
+}
+static void RetagAll(){
+    g_rowsDirty=true; g_tags.Clear(); for(size_t i=0;i<g_app.library.size();i++)AutoTag(i);
+}
+static void CheckTagMonth(){   // "played:month" rolls over with the calendar
+    static long long lastMin=-1; long long now=(long long)time(nullptr);
+    if(now/60==lastMin)return; lastMin=now/60;
+    int m=MonthOf(now); if(m!=g_tagMonth){g_tagMonth=m;RetagAll();}
+}
+static void RebuildRows(){
+    g_rowsDirty=false; g_rows.clear(); g_rowOf.clear();
+    if(g_filter.Empty())return;
+    size_t n=g_app.library.size(); std::vector<char> hit(n,0);
+    g_filter.Evaluate(g_tags,(uint32_t)n).ForEach([&](uint32_t p){if(p<n)hit[p]=1;});
+    g_rowOf.assign(n,-1);
+    for(size_t r=0;r<n;r++){int p=g_views.At((LibraryView)g_app.libraryView,r);if(hit[p]){g_rowOf[p]=(int)g_rows.size();g_rows.push_back(p);}}
+}
+// One entry was re-tagged or re-placed in the views: move just its row. The
+// other rows keep their relative order, so g_rows stays sorted by view rank.
+static void PlaceRow(size_t pos){
+    if(g_filter.Empty()||g_rowsDirty)return;   // nothing to keep, or rebuilt on next use
+    auto v=(LibraryView)g_app.libraryView;
+    if(pos>=g_rowOf.size())g_rowOf.resize(pos+1,-1);
+    int was=g_rowOf[pos], now=-1; g_rowOf[pos]=-1;
+    if(was>=0)g_rows.erase(g_rows.begin()+was);
+    if(g_filter.Matches(g_tags,(uint32_t)pos)){
+        int rank=g_views.RowOf(v,pos);
+        auto it=std::lower_bound(g_rows.begin(),g_rows.end(),rank,[&](int p,int r){return g_views.RowOf(v,p)<r;});
+        now=(int)(it-g_rows.begin()); g_rows.insert(it,(int)pos);
+    }
+    if(was<0&&now<0)return;
+    int lo=was<0?now:now<0?was:std::min(was,now), hi=(was<0||now<0)?(int)g_rows.size()-1:std::max(was,now);
+    for(int r=lo;r<=hi&&r<(int)g_rows.size();r++)g_rowOf[g_rows[r]]=r;
+}
+int LibraryAt(int row){
+    if(row<0)return -1;
+    if(g_filter.Empty())return g_views.At((LibraryView)g_app.libraryView,(size_t)row);
+    if(g_rowsDirty)RebuildRows();
+    return row<(int)g_rows.size()?g_rows[row]:-1;
+}
+int LibraryRowOf(int pos){
+    if(pos<0)return -1;
+    if(g_filter.Empty())return g_views.RowOf((LibraryView)g_app.libraryView,(size_t)pos);
+    if(g_rowsDirty)RebuildRows();
+    return pos<(int)g_rowOf.size()?g_rowOf[pos]:-1;
+}
+int LibraryRowCount(){
+    if(g_filter.Empty())return (int)g_app.library.size();
+    if(g_rowsDirty)RebuildRows();
+    return (int)g_rows.size();
+}
+static void UpdateViews(int pos){   // re-places and re-tags one entry; focus stays on its game
+    int f=LibraryAt(g_app.focused); g_views.Update(pos,KeysOf(g_app.library[pos])); AutoTag(pos);
+    if(f>=0){int r=LibraryRowOf(f);if(r>=0)g_app.focused=r;}
+}
+
+static void PushLoadedGame(GameInfo&& gi){   // duplicates from older builds fold into the first entry
+    if(gi.name.empty()||gi.exePath.empty()||g_libIndex.Find(gi)>=0)return;
+    g_libIndex.Insert(gi,g_app.library.size());
+    g_app.library.push_back(MakeUIGame(std::move(gi))); g_posOfUid[g_app.library.back().uid]=(int)g_app.library.size()-1;
+    g_views.Append(KeysOf(g_app.library.back())); AutoTag(g_app.library.size()-1);
+}
+// library.txt is the import/export format: read it only when there is no
+// snapshot yet or the text was edited after the snapshot was written.
+static void ImportLibraryText(const std::string& p){
     std::ifstream f(p); std::string l;
     while(std::getline(f,l)){if(l.empty())continue;std::stringstream ss(l);std::string n,e,pl,id;
         std::getline(ss,n,'|');std::getline(ss,e,'|');std::getline(ss,pl,'|');std::getline(ss,id,'|');
-        if(!n.empty()&&!e.empty())g_app.library.push_back({{n,e,pl,id}});}
+        PushLoadedGame({n,e,pl,id});}
 }
-
-void RefreshLibrary(){
-    auto sc=GetInstalledGames(); bool nw=false;
-    for(auto& s:sc){bool ex=false;for(auto& lib:g_app.library)if(lib.info.exePath==s.exePath){ex=true;break;}
-        if(!ex){g_app.library.push_back({s});nw=true;}}
-    if(nw){SaveProfile();ShowNotification("Library Updated",std::to_string(sc.size())+" games found",1);}
+void LoadLibraryFromDisk(){
+    std::string bin=GetFullPath("profile\\library.bin"),txt=GetFullPath("profile\\library.txt");
+    LARGE_INTEGER q0,q1,qf; QueryPerformanceCounter(&q0);
+    std::error_code ec; auto tb=fs::last_write_time(bin,ec); bool haveBin=!ec; auto tt=fs::last_write_time(txt,ec); bool haveTxt=!ec;
+    LibrarySnapshot snap; const char* from="none";
+    g_views.BeginBulk();
+    if(haveBin&&!(haveTxt&&tt>tb)&&snap.Open(bin)){
+        g_app.library.reserve(snap.Count()); g_libIndex.Reserve(snap.Count());
+        for(size_t i=0;i<snap.Count();i++){auto r=snap.Record(i);
+            PushLoadedGame({std::string(r.name),std::string(r.exePath),std::string(r.platform),std::string(r.appId)});}
+        from="library.bin";
+    } else if(haveTxt){ImportLibraryText(txt);from="library.txt";}
+    g_views.EndBulk();
+    QueryPerformanceCounter(&q1); QueryPerformanceFrequency(&qf);
+    DebugLog("[library] loaded "+std::to_string(g_app.library.size())+" games from "+from+" in "+
+             std::to_string((q1.QuadPart-q0.QuadPart)*1000000/qf.QuadPart)+" us");
+}
+
+// Posters come from the art store by key; decoded bitmaps are shared by
+// content hash, so identical art is one D2D bitmap however many cards show it.
+struct SharedPoster{ D2DBitmap bmp={}; int refs=0; };
+static std::unordered_map<uint64_t,SharedPoster> g_posterCache;
+void LoadGamePoster(UIGame& g){
+    if(g.hasPoster||g_journalReplay)return;
+    ArtEntry e; if(!Posters().Find(g.artKey,e))return;
+    auto& sp=g_posterCache[e.hash];
+    if(!sp.bmp.Valid()){sp.bmp=D2D().LoadBitmapA(Posters().PathOf(e).c_str());if(!sp.bmp.Valid()){g_posterCache.erase(e.hash);return;}}
+    sp.refs++; g.poster=sp.bmp; g.posterHash=e.hash; g.hasPoster=true;
+}
+void ReleaseGamePoster(UIGame& g){
+    if(!g.hasPoster)return;
+    auto it=g_posterCache.find(g.posterHash);
+    if(it!=g_posterCache.end()&&--it->second.refs<=0){D2D().UnloadBitmap(it->second.bmp);g_posterCache.erase(it);}
+    g.poster={}; g.hasPoster=false; g.posterHash=0;
+}
+void LoadGamePosters(){ for(auto& g:g_app.library)LoadGamePoster(g); }
+
+// Older builds saved art as img\<display name>.png/.jpg. Runs once, when there
+// is no art manifest yet; the legacy files are left where they are.
+void MigrateLegacyPosters(){
+    for(auto& g:g_app.library)for(auto e:{".png",".jpg"}){
+        std::string p=GetFullPath("img\\"+g.info.name+e);
+        if(fs::exists(p)&&Posters().Ingest(p,g.artKey,false))break;}
+    Posters().Save();
+}
+
+// Every library mutation goes through these so posters, focus, plugins and
+// the journal stay consistent. An entry matches on exe path or on (platform, appId).
+static void JournalGame(JournalRecord::Type t,const GameInfo& g){
+    if(!g_journalReplay)Journal().Append({t,{g.name,g.exePath,g.platform,g.appId}});
+}
+static void JournalArt(uint64_t key){
+    ArtEntry e; if(g_journalReplay||!Posters().Find(key,e))return;
+    Journal().Append({JournalRecord::UPDATE_ART,{ArtStore::KeyString(key),ArtStore::KeyString(e.hash),
+                      std::to_string(e.w),std::to_string(e.h),e.ext}});
+}
+int FindLibraryEntry(const GameInfo& g){ return g_libIndex.Find(g); }
+bool AddLibraryEntry(const GameInfo& g){
+    if(FindLibraryEntry(g)>=0)return false;
+    // Focus on the trailing "add" tile stays on it as games stream in.
+    bool onAddTile=!g_app.library.empty()&&g_app.focused==LibraryRowCount();
+    g_libIndex.Insert(g,g_app.library.size());
+    g_app.library.push_back(MakeUIGame(g)); LoadGamePoster(g_app.library.back());
+    g_posOfUid[g_app.library.back().uid]=(int)g_app.library.size()-1;
+    g_views.Append(KeysOf(g_app.library.back())); AutoTag(g_app.library.size()-1);
+    if(onAddTile)g_app.focused=LibraryRowCount();
+    JournalGame(JournalRecord::ADD,g);
+    return true;
+}
+bool UpdateLibraryEntry(const GameInfo& prev,const GameInfo& g){
+    int i=FindLibraryEntry(prev); if(i<0)i=FindLibraryEntry(g); if(i<0)return AddLibraryEntry(g);
+    auto& e=g_app.library[i].info;
+    if(e.exePath==g.exePath&&e.platform==g.platform&&e.appId==g.appId)return false;
+    e.exePath=g.exePath;e.platform=g.platform;e.appId=g.appId;   // keep the name the user sees
+    g_libIndex.Update(i,e);
+    auto& G=g_app.library[i]; uint64_t k=ArtStore::KeyFor(e); G.platform=InternPlatform(e.platform);
+    if(k!=G.artKey){ReleaseGamePoster(G);G.artKey=k;LoadGamePoster(G);ApplyPlayStats(G);}
+    ApplyInstallSize(G,true);   // moved, or updated by its store: re-list the whole tree
+    ApplyFingerprint(G);
+    g_search.Add(G.uid,e.name,e.platform); UpdateViews(i);
+    JournalGame(JournalRecord::ADD,e);   // replays as an upsert
+    return true;
+}
+void RemoveLibraryEntryAt(int i){
+    auto& L=g_app.library; if(i<0||i>=(int)L.size())return;
+    JournalGame(JournalRecord::REMOVE,L[i].info);
+    ReleaseGamePoster(L[i]);   // its store entry stays: art survives a reinstall
+    g_search.Remove(L[i].uid); UnlinkSizeRoot(L[i]); SetPrint(L[i],{}); g_posOfUid.erase(L[i].uid);
+    int r=LibraryRowOf(i);   // focus and card animation are by row; -1 if filtered out
+    L.erase(L.begin()+i); g_libIndex.Erase(i); g_views.Erase(i); g_tags.ErasePosition((uint32_t)i); g_rowsDirty=true;
+    for(size_t k=i;k<L.size();k++)g_posOfUid[L[k].uid]=(int)k;
+    if(r>=0){
+        g_app.cardAnim.OnErase(r);
+        // Keep focus on the same game; if the focused one went, step back onto
+        // its neighbour rather than sliding onto the "add" tile.
+        if(g_app.focused>r||(g_app.focused==r&&r>0&&r==LibraryRowCount()))g_app.focused--;
+        if(g_app.focused==r)g_app.showDetails=false;
+    }
+    g_app.focused=Clamp(g_app.focused,0,LibraryRowCount());
+}
+// Switches the library tab's order and keeps the focused game focused.
+void SetLibraryView(int v){
+    if(v<0||v>=VIEW_COUNT||v==g_app.libraryView)return;
+    int pos=LibraryAt(g_app.focused);
+    g_app.libraryView=v; g_app.cardAnim=CardAnim{}; g_rowsDirty=true;
+    if(pos>=0)g_app.focused=LibraryRowOf(pos);
+    JournalSettings("config"); PM().NotifyLibraryChanged();   // plugin indices are view rows
+}
+// Narrows the library tab (and plugin indices) to entries matching expr; an
+// empty expression shows everything. Focus stays on its game if it still shows.
+void SetLibraryFilter(const std::string& expr){
+    TagFilter f=TagFilter::Parse(expr); if(f.ToString()==g_filter.ToString())return;
+    int pos=LibraryAt(g_app.focused);
+    g_filter=std::move(f); g_rowsDirty=true; g_app.cardAnim=CardAnim{}; g_app.showDetails=false;
+    int r=LibraryRowOf(pos); g_app.focused=r>=0?r:0;
+    JournalSettings("tags"); PM().NotifyLibraryChanged();
+}
+std::string LibraryFilterText(){ return g_filter.ToString(); }
+std::vector<std::string> LibraryTagsOf(int pos){
+    return (pos<0||pos>=(int)g_app.library.size())?std::vector<std::string>{}:g_tags.TagsOf((uint32_t)pos);
+}
+// Adds or removes the game at pos from a user collection; an emptied
+// collection is dropped.
+static void SetCollection(const std::string& name,int pos,bool on){
+    std::string n=TagIndex::Normalize(name); if(n.empty()||n.find(':')!=std::string::npos||pos<0)return;
+    auto& keys=g_collections[n]; uint64_t k=g_app.library[pos].artKey;
+    if(on)keys.insert(k); else keys.erase(k);
+    if(keys.empty()){g_collections.erase(n);g_tags.Drop(n);}
+    for(size_t i=0;i<g_app.library.size();i++)if(g_app.library[i].artKey==k)AutoTag(i);   // every entry with that key
+    JournalSettings("tags"); if(!g_filter.Empty())PM().NotifyLibraryChanged();
+}
+// tags.txt: the active filter and the user collections, by game key.
+//   F|<filter>
+//   C|<name>|<key hex>,<key hex>,...
+static std::string TagsText(){
+    std::ostringstream t; t<<"F|"<<g_filter.ToString()<<"\n";
+    for(auto& [name,keys]:g_collections){
+        t<<"C|"<<name<<"|"; bool first=true;
+        for(uint64_t k:keys){if(!first)t<<",";t<<ArtStore::KeyString(k);first=false;}
+        t<<"\n";
+    }
+    return t.str();
 }
-
-void LoadGamePosters(){
-    for(auto& g:g_app.library){if(g.hasPoster)continue;
-        for(auto e:{".png",".jpg"}){std::string p=GetFullPath("img\\"+g.info.name+e);
-            if(fs::exists(p)){g.poster=D2D().LoadBitmapA(p.c_str());g.hasPoster=g.poster.Valid();if(g.hasPoster)break;}}}
+static void ParseTags(std::istream& f){
+    g_collections.clear(); g_filter=TagFilter{}; std::string line;
+    while(std::getline(f,line)){
+        if(line.size()<2||line[1]!='|')continue;
+        if(line[0]=='F'){g_filter=TagFilter::Parse(line.substr(2));continue;}
+        if(line[0]!='C')continue;
+        size_t bar=line.find('|',2); if(bar==std::string::npos)continue;
+        std::string name=TagIndex::Normalize(line.substr(2,bar-2)); if(name.empty())continue;
+        std::stringstream ss(line.substr(bar+1)); auto& keys=g_collections[name];
+        for(std::string k;std::getline(ss,k,',');)if(uint64_t v=ArtStore::ParseKey(k))keys.insert(v);
+    }
+    RetagAll(); g_rowsDirty=true; g_app.focused=0;
+}
+// Startup, before the library loads, so entries are tagged as they stream in.
+void LoadTags(){
+    CheckTagMonth();
+    std::ifstream f(GetFullPath("profile\\tags.txt")); if(f)ParseTags(f);
+}
+// Session tracker completion (UI thread): copy the new totals onto every
+// entry with that key and re-place them in the views.
+static void OnSessionEvent(const SessionEvent& e){
+    for(size_t i=0;i<g_app.library.size();i++){auto& G=g_app.library[i]; if(G.artKey!=e.game)continue;
+        G.lastPlayed=e.stats.lastPlayed; G.playtimeSec=e.stats.playtime; UpdateViews((int)i);}
+}
+// Size walk completion (UI thread): entries installed in that folder.
+static bool TryRebind(int pos,bool exists);
+static void OnSizeResult(const SizeResult& r){
+    auto it=g_uidsBySizeRoot.find(r.root); if(it==g_uidsBySizeRoot.end())return;
+    std::vector<uint32_t> retry;
+    for(uint32_t u:it->second){int i=PositionOfUid(u); if(i<0)continue; auto& G=g_app.library[i]; if(G.sizeBytes==r.bytes)continue;
+        G.sizeBytes=r.bytes; UpdateViews(i); if(G.print.Valid())retry.push_back(u);}
+    // A moved install's size can land after its fingerprint and confirm the match.
+    bool changed=false;
+    for(uint32_t u:retry){int i=PositionOfUid(u); if(i>=0)changed|=TryRebind(i,true);}
+    if(changed)PM().NotifyLibraryChanged();
+}
+// A moved install shows up as a new entry while the old one points at an exe
+// that is gone. Store games are matched by (platform, appId) in the scan
+// merge; anything else is matched here by exe fingerprint plus file name.
+// The old entry keeps its place and name and takes the new path; art, play
+// stats and collections follow it to the new key, and the duplicate goes.
+// Stock runtimes (RPG Maker's Game.exe, ...) are byte-identical across
+// games, so the exe alone is not enough: the install folder must carry the
+// same name or the same measured size, and two different store ids never merge.
+static bool SameInstall(const UIGame& a,const UIGame& b){
+    auto leaf=[](const UIGame& g){return LibraryIndex::ExeKey(fs::path(DirSizeIndex::InstallRoot(g.info.exePath)).filename().string());};
+    uint64_t la=leaf(a); if(la&&la==leaf(b))return true;
+    return a.sizeBytes&&a.sizeBytes==b.sizeBytes;
+}
+static bool TryRebind(int pos,bool exists){
+    auto& L=g_app.library; const auto& P=L[pos];
+    uint64_t name=LibraryIndex::ExeKey(fs::path(P.info.exePath).filename().string());
+    auto bucket=g_uidsByPrint.find(P.print.hash); if(bucket==g_uidsByPrint.end())return false;
+    std::vector<uint32_t> same=bucket->second;   // a rebind below edits the bucket
+    for(uint32_t u:same){int j=PositionOfUid(u);
+        if(j<0||j==pos||L[j].print!=P.print||L[j].info.exePath==P.info.exePath)continue;
+        if(LibraryIndex::ExeKey(fs::path(L[j].info.exePath).filename().string())!=name)continue;
+        const auto& Q=L[j].info;
+        if(!P.info.appId.empty()&&!Q.appId.empty()&&(P.info.platform!=Q.platform||P.info.appId!=Q.appId))continue;
+        if(!SameInstall(P,L[j]))continue;
+        int dead=exists?j:pos, live=exists?pos:j;
+        std::error_code ec;
+        if(fs::exists(L[dead].info.exePath,ec)||!fs::exists(L[live].info.exePath,ec))continue;
+        GameInfo was=L[dead].info, now=L[live].info; now.name=was.name;
+        uint64_t from=L[dead].artKey, to=ArtStore::KeyFor(now);
+        if(from!=to){
+            ArtEntry e; if(!Posters().Find(to,e)&&Posters().Find(from,e)){Posters().Put(to,e);JournalArt(to);}
+            Sessions().Rekey(from,to);
+            bool moved=false;
+            for(auto& [cn,keys]:g_collections)if(keys.erase(from)){keys.insert(to);moved=true;}
+            if(moved)JournalSettings("tags");
+        }
+        RemoveLibraryEntryAt(live);
+        JournalGame(JournalRecord::REMOVE,was);   // a replayed upsert can't find a manual entry by its old path
+        UpdateLibraryEntry(was,now);
+        DebugLog("[library] "+was.name+" moved: "+was.exePath+" -> "+now.exePath);
+        ShowNotification("Game Moved",was.name,1);
+        return true;
+    }
+    return false;
+}
+// Fingerprint completion (UI thread): results come back by uid.
+static void OnFingerprints(const std::vector<FingerprintResult>& batch){
+    bool changed=false;
+    for(auto& r:batch){
+        int i=PositionOfUid((uint32_t)r.tag); if(i<0)continue;
+        auto& G=g_app.library[i]; if(G.info.exePath!=r.path)continue;
+        SetPrint(G,r.print);
+        if(G.print.Valid()&&TryRebind(i,r.exists))changed=true;
+    }
+    if(changed)PM().NotifyLibraryChanged();
+}
+bool RemoveLibraryEntry(const GameInfo& g){
+    int i=FindLibraryEntry(g); if(i<0)return false;
+    RemoveLibraryEntryAt(i); return true;
+}
+// Ranked fuzzy matches as library positions. Hits come back by uid; one pass
+// over the library maps them to where they sit now.
+int SearchLibrary(const std::string& q,int limit,std::vector<int>& out){
+    static std::vector<SearchHit> hits; static std::unordered_map<uint32_t,size_t> rank;
+    out.clear(); g_search.Query(q,(size_t)std::max(limit,0),hits); if(hits.empty())return 0;
+    rank.clear(); for(size_t r=0;r<hits.size();r++)rank[hits[r].id]=r;
+    out.assign(hits.size(),-1);
+    for(size_t i=0;i<g_app.library.size();i++){auto it=rank.find(g_app.library[i].uid);if(it!=rank.end())out[it->second]=(int)i;}
+    out.erase(std::remove(out.begin(),out.end(),-1),out.end());
+    return (int)out.size();
+}
+
+// Art fetcher completion (UI thread, via DispatchCompletions): file the new
+// art in the store and swap it onto the card. A card that has art keeps it.
+void OnArtFetched(const ArtResult& r){
+    if(!r.ok)return;
+    uint64_t key=ArtStore::ParseKey(r.tag);
+    if(!Posters().Ingest(r.dest,key,true))return;
+    JournalArt(key);
+    for(auto& g:g_app.library)if(g.artKey==key)LoadGamePoster(g);
+}
+
+// Startup, before D2D: base files are loaded, now apply what happened since
+// they were last written.
+void ReplayProfileJournal(){
+    std::string path=GetFullPath("profile\\journal.bin");
+    g_journalReplay=true;
+    size_t n=Journal().Replay(path,[](const JournalRecord& r){
+        auto& f=r.fields;
+        switch(r.type){
+            case JournalRecord::ADD: if(f.size()==4){GameInfo g{f[0],f[1],f[2],f[3]};int i=FindLibraryEntry(g);
+                if(i<0)AddLibraryEntry(g);else UpdateLibraryEntry(g_app.library[i].info,g);} break;
+            case JournalRecord::REMOVE: if(f.size()==4)RemoveLibraryEntry({f[0],f[1],f[2],f[3]}); break;
+            case JournalRecord::UPDATE_ART: if(f.size()==5&&f[4].size()<sizeof(ArtEntry::ext)){ArtEntry e;
+                e.hash=ArtStore::ParseKey(f[1]);try{e.w=std::stoi(f[2]);e.h=std::stoi(f[3]);}catch(...){}
+                memcpy(e.ext,f[4].c_str(),f[4].size()+1);Posters().Put(ArtStore::ParseKey(f[0]),e);} break;
+            case JournalRecord::SETTINGS: if(f.size()==2){std::istringstream in(f[1]);
+                if(f[0]=="config")ParseConfig(in);else if(f[0]=="apps")ParseApps(in);else if(f[0]=="tags")ParseTags(in);} break;
+        }
+    });
+    g_journalReplay=false;
+    if(n)DebugLog("[journal] replayed "+std::to_string(n)+" records");
+    Journal().Open(path);
+}
+
+// Startup scan + manifest watcher. Both feed one queue that is applied here,
+// once per frame, on the UI thread. While the startup scan streams in, new
+// games are inserted live but notifications wait for SCAN_COMPLETE.
+static LibraryWatcher g_libWatcher;
+void ApplyLibraryDeltas(){
+    static std::vector<LibraryDelta> batch; batch.clear();
+    static int scanAdded=0;
+    if(!g_libWatcher.Drain(batch))return;
+    int added=0,updated=0,removed=0; const LibraryDelta* done=nullptr; std::string lastName;
+    for(auto& d:batch)switch(d.kind){
+        case LibraryDelta::ADD:    if(AddLibraryEntry(d.game)){added++;lastName=d.game.name;} break;
+        case LibraryDelta::UPDATE: updated+=UpdateLibraryEntry(d.previous,d.game); break;
+        case LibraryDelta::REMOVE: removed+=RemoveLibraryEntry(d.game); break;
+        case LibraryDelta::SCAN_COMPLETE: done=&d; break;
+    }
+    bool scanning=g_libWatcher.IsScanning()||done;
+    if(done){
+        // Reconcile against the complete scan: streamed ADDs already covered
+        // new games, so this picks up moved installs and vanished ones.
+        auto& snap=done->snapshot;
+        LARGE_INTEGER q0,q1,qf; QueryPerformanceCounter(&q0);
+        auto mr=g_libIndex.Merge(snap);
+        QueryPerformanceCounter(&q1); QueryPerformanceFrequency(&qf);
+        for(auto& m:mr.moved){GameInfo prev=g_app.library[m.first].info;updated+=UpdateLibraryEntry(prev,snap[m.second]);}
+        for(size_t a:mr.added)added+=AddLibraryEntry(snap[a]);
+        // Only drop entries whose exe is really gone; walk back so indices hold.
+        for(auto it=mr.vanished.rbegin();it!=mr.vanished.rend();++it)
+            if(!fs::exists(g_app.library[*it].info.exePath)){RemoveLibraryEntryAt((int)*it);removed++;}
+        DebugLog("[library] merged "+std::to_string(snap.size())+" scanned into "+std::to_string(g_libIndex.Size())+
+                 " entries in "+std::to_string((q1.QuadPart-q0.QuadPart)*1000000/qf.QuadPart)+" us: "+
+                 std::to_string(mr.added.size())+" new, "+std::to_string(mr.moved.size())+" moved, "+
+                 std::to_string(mr.vanished.size())+" vanished, "+std::to_string(mr.duplicates)+" duplicates");
+    }
+    if(scanning)scanAdded+=added;
+    if(added||updated||removed)PM().NotifyLibraryChanged();
+    if(scanning){
+        // One save + one summary when the startup scan finishes.
+        if(!done)return;
+        if(scanAdded||updated||removed)SaveProfile();
+        if(scanAdded)ShowNotification("Library Updated",std::to_string(scanAdded)+" new games found",1);
+        scanAdded=0; return;
+    }
+    if(!added&&!updated&&!removed)return;
+    if(added==1&&!removed)ShowNotification("Game Installed",lastName,1);
+    else if(added||removed)ShowNotification("Library Updated",std::to_string(added)+" added, "+std::to_string(removed)+" removed",1);
 }
 void LoadCustomAppIcons(){
     for(auto& app:g_app.customApps){if(app.hasIcon||app.iconPath.empty())continue;
@@ -863,9 +1460,14 @@ void SwitchToTask(int i){
     HWND h=g_app.tasks[i].hwnd; if(!IsWindow(h))return;
     PushMainWindowBack(); Sleep(50); BringWindowToFront(h);
 }
-void LaunchApp(const std::string& path,bool isWeb=false){
-    if(path.empty())return;
-    if(isWeb||path.find("://")!=std::string::npos){ShellExecuteA(nullptr,"open",path.c_str(),nullptr,nullptr,SW_SHOWNORMAL);return;}
+// With keepProcess the launched process handle is returned (caller closes it);
+// URLs and failed launches give nullptr. *launched tells those two apart.
+HANDLE LaunchApp(const std::string& path,bool isWeb=false,bool keepProcess=false,bool* launched=nullptr){
+    if(launched)*launched=false;
+    if(path.empty())return nullptr;
+    if(isWeb||path.find("://")!=std::string::npos){
+        bool ok=(INT_PTR)ShellExecuteA(nullptr,"open",path.c_str(),nullptr,nullptr,SW_SHOWNORMAL)>32;
+        if(launched)*launched=ok; return nullptr;}
     // Extract parent directory only — do NOT assign full path to dir first,
     // otherwise a path with no separator would pass the exe filename as lpDirectory
     // and cause ShellExecuteEx to crash with an access violation.
@@ -876,7 +1478,19 @@ void LaunchApp(const std::string& path,bool isWeb=false){
     s.lpFile=path.c_str();
     s.lpDirectory=dir.empty()?nullptr:dir.c_str();  // nullptr = let shell resolve; never pass garbage
     s.nShow=SW_SHOWNORMAL;
-    ShellExecuteExA(&s);if(s.hProcess)CloseHandle(s.hProcess);
+    if(!ShellExecuteExA(&s))return nullptr;
+    if(launched)*launched=true;
+    if(s.hProcess&&!keepProcess){CloseHandle(s.hProcess);return nullptr;}
+    return s.hProcess;
+}
+void LaunchGame(int pos){
+    if(pos<0||pos>=(int)g_app.library.size())return;
+    auto& G=g_app.library[pos];
+    // lastPlayed arrives through OnSessionEvent, so a failed launch leaves it alone.
+    bool ok=false; HANDLE h=LaunchApp(G.info.exePath,false,true,&ok);
+    if(h)Sessions().Track(G.artKey,h);
+    else if(ok)Sessions().Touch(G.artKey);
+    else{ShowNotification("Error","Couldn't launch "+G.info.name,3);PlayErrorSound();}
 }
 std::string OpenFilePicker(bool exe){
     char b[MAX_PATH]={}; OPENFILENAMEA o={};
@@ -919,7 +1533,7 @@ void LoadBackground(const std::string& p){
 }
 void ChangeBackground(){
     auto p=OpenFilePicker(false);if(p.empty())return;
-    g_app.bgPath=p;LoadBackground(p);SaveProfile();ShowNotification("Background Changed","New wallpaper set",1);
+    g_app.bgPath=p;LoadBackground(p);JournalSettings("config");ShowNotification("Background Changed","New wallpaper set",1);
 }
 void DrawBackground(int w,int h,float alpha=1.f){
     float _time=GetTime();
@@ -1028,7 +1642,8 @@ void DrawBottomBar(int sw,int sh,float time){
     float pulse=(sinf(time*4)+1)/2;
     D2D().FillRoundRect((float)(sw-280),y+12,250,45,22,22,CA(t.accent,0.1f+pulse*0.1f));
     D2D().DrawTextA("[B] SET BACKGROUND",(float)(sw-240),y+27,14,t.text);
-    const char* hints[]={"[A] Launch | [Y] Art | [X] Delete","[A] Open | [X] Remove | [+] Add","[A] Select | [Arrows] Navigate","[A] Select | [Arrows] Navigate"};
+    std::string lib=std::string("[A] Launch | [Y] Art | [X] Delete | [V] ")+LibraryViews::Name((LibraryView)s.libraryView)+" | [/] Search | [F] Filter | [C] Collections";
+    const char* hints[]={lib.c_str(),"[A] Open | [X] Remove | [+] Add","[A] Select | [Arrows] Navigate","[A] Select | [Arrows] Navigate"};
     int hi=Clamp(s.barFocused,0,3); float hw=D2D().MeasureTextA(hints[hi],14);
     D2D().DrawTextA(hints[hi],(sw-hw)/2,y+28,14,CA(t.textDim,0.6f));
 }
@@ -1124,13 +1739,188 @@ void DrawMediaTab(int sw,int sh,float contentTop,InputAdapter& input,float dt){
             std::string name=s.customApps[s.mediaFocusIdx].name;
             s.customApps.erase(s.customApps.begin()+s.mediaFocusIdx);
             s.mediaFocusIdx=Clamp(s.mediaFocusIdx,0,std::max(0,(int)s.customApps.size()-1));
-            SaveProfile();ShowNotification("Removed",name,3);PlayBackSound();}
+            JournalSettings("apps");ShowNotification("Removed",name,3);PlayBackSound();}
     }
     D2D().FillRect((float)baseX,(float)(sh-75),(float)contentW,1,CA(t.accent,0.1f));
     D2D().DrawTextA("[A] Launch  |  [X] Remove  |  [+] Add App  |  [LB/RB] Switch Tabs",(float)(baseX+20),(float)(sh-60),12,CA(t.textDim,0.5f));
     (void)dt;
 }
 
+// ============================================================================
+// SEARCH OVERLAY
+// ============================================================================
+
+static size_t g_searchLibSize=0;   // library size the hits were computed for
+
+static void OpenSearchOverlay(){
+    auto& s=g_app; while(GetCharPressed()>0){}   // drop the '/' that opened us
+    s.searchQuery.clear(); s.searchHits.clear(); s.searchFocus=0;
+    s.currentMode=UIMode::SEARCH;
+}
+
+void HandleSearchOverlay(int sw,int sh,InputAdapter& input){
+    auto& s=g_app; auto& t=s.theme;
+    // Input first so the list drawn this frame already matches the query.
+    bool edited=false;
+    for(int k=GetCharPressed();k>0;k=GetCharPressed())if(k>=32&&k<127&&s.searchQuery.size()<48){s.searchQuery+=(char)k;edited=true;}
+    if(IsKeyPressed(VK_BACK)&&!s.searchQuery.empty()){s.searchQuery.pop_back();edited=true;}
+    if(edited||g_searchLibSize!=s.library.size()){   // positions shift when the library does
+        SearchLibrary(s.searchQuery,50,s.searchHits); g_searchLibSize=s.library.size();
+        if(edited)s.searchFocus=0;
+        s.searchFocus=Clamp(s.searchFocus,0,std::max(0,(int)s.searchHits.size()-1));
+    }
+    if(input.IsTextCancel()){s.currentMode=UIMode::MAIN;PlayBackSound();return;}
+    if(input.IsTextUp()&&s.searchFocus>0){s.searchFocus--;PlayMoveSound();}
+    if(input.IsTextDown()&&s.searchFocus<(int)s.searchHits.size()-1){s.searchFocus++;PlayMoveSound();}
+    if(input.IsTextConfirm()&&!s.searchHits.empty()){
+        int pos=s.searchHits[s.searchFocus]; if(LibraryRowOf(pos)<0)SetLibraryFilter("");   // filtered out: show everything
+        s.barFocused=0; s.focused=LibraryRowOf(pos); s.inTopBar=s.showDetails=false;
+        s.currentMode=UIMode::MAIN; PlayConfirmSound(); return;
+    }
+
+    float pulse=(sinf(GetTime()*4)+1)/2;
+    D2D().FillRect(0,0,(float)sw,(float)sh,CA(BLACK_COL,0.88f));
+    const int ROWS=8,ROW_H=44;
+    int pW=640,pH=150+ROWS*ROW_H,pX=(sw-pW)/2,pY=(sh-pH)/2;
+    D2D().FillRoundRect((float)pX,(float)pY,(float)pW,(float)pH,8,8,CA(t.secondary,0.98f));
+    D2D().FillGradientV((float)pX,(float)pY,(float)pW,6,t.accent,CA(t.accent,0.3f));
+    D2D().StrokeRoundRect((float)pX,(float)pY,(float)pW,(float)pH,8,8,1.f,CA(t.accent,0.35f));
+    D2D().DrawTextA("SEARCH LIBRARY",(float)(pX+30),(float)(pY+25),24,t.text,(DWRITE_FONT_WEIGHT)700);
+    D2D().DrawTextA("[Esc] Close",(float)(pX+pW-105),(float)(pY+28),13,t.textDim);
+    D2D().FillRoundRect((float)(pX+30),(float)(pY+65),(float)(pW-60),42,9,9,CA(t.cardBg,0.85f));
+    D2D().StrokeRoundRect((float)(pX+30),(float)(pY+65),(float)(pW-60),42,9,9,1.f,CA(t.accent,0.5f+pulse*0.3f));
+    D2D().DrawTextA((s.searchQuery+"_").c_str(),(float)(pX+48),(float)(pY+77),15,t.text);
+    int top=std::max(0,std::min(s.searchFocus-ROWS/2,(int)s.searchHits.size()-ROWS));
+    for(int r=0;r<ROWS&&top+r<(int)s.searchHits.size();r++){
+        int li=s.searchHits[top+r]; if(li<0||li>=(int)s.library.size())continue;
+        auto& g=s.library[li]; bool foc=(top+r==s.searchFocus); float ry=(float)(pY+125+r*ROW_H);
+        if(foc)D2D().FillRoundRect((float)(pX+30),ry,(float)(pW-60),(float)(ROW_H-6),6,6,CA(t.accent,0.22f));
+        D2D().DrawTextA(g.info.name.c_str(),(float)(pX+48),ry+9,16,foc?t.text:t.textDim);
+        const std::string& pl=PlatformName(g.platform); float pw=D2D().MeasureTextA(pl.c_str(),12);
+        D2D().DrawTextA(pl.c_str(),(float)(pX+pW-48)-pw,ry+12,12,CA(t.textDim,0.7f));
+    }
+    if(s.searchHits.empty()&&!s.searchQuery.empty())
+        D2D().DrawTextA("No matches",(float)(pX+48),(float)(pY+135),15,CA(t.textDim,0.6f));
+}
+
+// ============================================================================
+// TAG FILTER / COLLECTION OVERLAYS
+// ============================================================================
+
+// The game the collections overlay edits, by uid: watcher deltas keep landing
+// while it is open and shift library positions under it.
+static uint32_t g_collectionUid=0;
+
+static void OpenFilterOverlay(){
+    auto& s=g_app; while(GetCharPressed()>0){}
+    s.filterBuffer=LibraryFilterText(); if(!s.filterBuffer.empty())s.filterBuffer+=' ';
+    s.tagFocus=0; s.currentMode=UIMode::FILTER;
+}
+static void OpenCollectionsOverlay(int pos){
+    auto& s=g_app; while(GetCharPressed()>0){}
+    s.collectionBuffer.clear(); s.tagFocus=0; g_collectionUid=pos>=0&&pos<(int)s.library.size()?s.library[pos].uid:0; s.currentMode=UIMode::COLLECTIONS;
+}
+// Shared frame for both overlays: panel, title, text field. Returns the y the list starts at.
+static int DrawTagPanel(int sw,int sh,int rows,const char* title,const std::string& field,int& pX,int& pW){
+    auto& t=g_app.theme; float pulse=(sinf(GetTime()*4)+1)/2;
+    D2D().FillRect(0,0,(float)sw,(float)sh,CA(BLACK_COL,0.88f));
+    pW=640; int pH=170+rows*40; pX=(sw-pW)/2; int pY=(sh-pH)/2;
+    D2D().FillRoundRect((float)pX,(float)pY,(float)pW,(float)pH,8,8,CA(t.secondary,0.98f));
+    D2D().FillGradientV((float)pX,(float)pY,(float)pW,6,t.accent,CA(t.accent,0.3f));
+    D2D().StrokeRoundRect((float)pX,(float)pY,(float)pW,(float)pH,8,8,1.f,CA(t.accent,0.35f));
+    D2D().DrawTextA(title,(float)(pX+30),(float)(pY+25),24,t.text,(DWRITE_FONT_WEIGHT)700);
+    D2D().DrawTextA("[Esc] Close",(float)(pX+pW-105),(float)(pY+28),13,t.textDim);
+    D2D().FillRoundRect((float)(pX+30),(float)(pY+65),(float)(pW-60),42,9,9,CA(t.cardBg,0.85f));
+    D2D().StrokeRoundRect((float)(pX+30),(float)(pY+65),(float)(pW-60),42,9,9,1.f,CA(t.accent,0.5f+pulse*0.3f));
+    D2D().DrawTextA((field+"_").c_str(),(float)(pX+48),(float)(pY+77),15,t.text);
+    return pY+145;
+}
+static bool EditTextField(std::string& buf,size_t max){
+    bool edited=false;
+    for(int k=GetCharPressed();k>0;k=GetCharPressed())if(k>=32&&k<127&&buf.size()<max){buf+=(char)k;edited=true;}
+    if(IsKeyPressed(VK_BACK)&&!buf.empty()){buf.pop_back();edited=true;}
+    return edited;
+}
+
+// Filter editor: type an expression, or pick tags from the list and cycle
+// each through AND (+) / NOT (-) / OR (|) with Right.
+void HandleFilterOverlay(int sw,int sh,InputAdapter& input){
+    auto& s=g_app; auto& t=s.theme; auto& all=g_tags.All();
+    EditTextField(s.filterBuffer,160);
+    if(input.IsTextCancel()){s.currentMode=UIMode::MAIN;PlayBackSound();return;}
+    if(input.IsTextUp()&&s.tagFocus>0){s.tagFocus--;PlayMoveSound();}
+    if(input.IsTextDown()&&s.tagFocus<(int)all.size()-1){s.tagFocus++;PlayMoveSound();}
+    TagFilter f=TagFilter::Parse(s.filterBuffer);
+    auto opOf=[&](const std::string& tag)->char{
+        for(auto* v:{&f.all,&f.none,&f.any})if(std::find(v->begin(),v->end(),tag)!=v->end())return v==&f.all?'+':v==&f.none?'-':'|';
+        return 0;
+    };
+    if(input.IsTextRight()&&!all.empty()){
+        auto it=std::next(all.begin(),Clamp(s.tagFocus,0,(int)all.size()-1)); const std::string& tag=it->first;
+        char op=opOf(tag);
+        for(auto* v:{&f.all,&f.none,&f.any})v->erase(std::remove(v->begin(),v->end(),tag),v->end());
+        if(op==0)f.all.push_back(tag); else if(op=='+')f.none.push_back(tag); else if(op=='-')f.any.push_back(tag);
+        s.filterBuffer=f.ToString(); if(!s.filterBuffer.empty())s.filterBuffer+=' '; PlayMoveSound();
+    }
+    if(input.IsTextConfirm()){
+        SetLibraryFilter(s.filterBuffer); s.barFocused=0; s.inTopBar=false;
+        s.currentMode=UIMode::MAIN; PlayConfirmSound(); return;
+    }
+
+    const int ROWS=8; int pX,pW;
+    int y=DrawTagPanel(sw,sh,ROWS,"FILTER LIBRARY",s.filterBuffer,pX,pW);
+    size_t hits=f.Empty()?s.library.size():f.Evaluate(g_tags,(uint32_t)s.library.size()).Cardinality();
+    std::string cnt=std::to_string(hits)+" of "+std::to_string(s.library.size())+" games  |  [Right] + / - / |  [Enter] Apply";
+    D2D().DrawTextA(cnt.c_str(),(float)(pX+34),(float)(y-30),12,CA(t.textDim,0.7f));
+    int top=std::max(0,std::min(s.tagFocus-ROWS/2,(int)all.size()-ROWS)); auto it=all.begin(); std::advance(it,top);
+    for(int r=0;r<ROWS&&it!=all.end();r++,++it){
+        bool foc=(top+r==s.tagFocus); float ry=(float)(y+r*40); char op=opOf(it->first);
+        if(foc)D2D().FillRoundRect((float)(pX+30),ry,(float)(pW-60),34,6,6,CA(t.accent,0.22f));
+        if(op){char o[2]={op,0};D2D().DrawTextA(o,(float)(pX+44),ry+7,16,op=='-'?t.danger:t.accent,(DWRITE_FONT_WEIGHT)700);}
+        D2D().DrawTextA(it->first.c_str(),(float)(pX+68),ry+7,16,foc||op?t.text:t.textDim);
+        std::string n=std::to_string(it->second.Cardinality()); float nw=D2D().MeasureTextA(n.c_str(),12);
+        D2D().DrawTextA(n.c_str(),(float)(pX+pW-48)-nw,ry+10,12,CA(t.textDim,0.7f));
+    }
+}
+
+// Collections for one game: Right toggles membership, Enter on typed text
+// creates a collection with the game in it.
+void HandleCollectionsOverlay(int sw,int sh,InputAdapter& input){
+    auto& s=g_app; auto& t=s.theme; int pos=PositionOfUid(g_collectionUid);
+    if(pos<0){s.currentMode=UIMode::MAIN;return;}   // removed meanwhile
+    uint64_t key=s.library[pos].artKey;
+    EditTextField(s.collectionBuffer,40);
+    if(input.IsTextCancel()){s.currentMode=UIMode::MAIN;PlayBackSound();return;}
+    if(input.IsTextUp()&&s.tagFocus>0){s.tagFocus--;PlayMoveSound();}
+    if(input.IsTextDown()&&s.tagFocus<(int)g_collections.size()-1){s.tagFocus++;PlayMoveSound();}
+    if(input.IsTextRight()&&!g_collections.empty()){
+        auto it=std::next(g_collections.begin(),Clamp(s.tagFocus,0,(int)g_collections.size()-1));
+        SetCollection(std::string(it->first),pos,!it->second.count(key)); PlayMoveSound();
+        s.tagFocus=Clamp(s.tagFocus,0,std::max(0,(int)g_collections.size()-1));
+    }
+    if(input.IsTextConfirm()){
+        if(s.collectionBuffer.empty()){s.currentMode=UIMode::MAIN;PlayConfirmSound();return;}
+        std::string n=TagIndex::Normalize(s.collectionBuffer);
+        if(n.empty()||n.find(':')!=std::string::npos){ShowNotification("Collections","Names can't contain ':'",3);PlayErrorSound();}
+        else{SetCollection(n,pos,true);ShowNotification("Added to "+n,s.library[pos].info.name,1);PlayConfirmSound();}
+        s.collectionBuffer.clear();
+    }
+
+    const int ROWS=8; int pX,pW;
+    int y=DrawTagPanel(sw,sh,ROWS,"COLLECTIONS",s.collectionBuffer,pX,pW);
+    D2D().DrawTextA((s.library[pos].info.name+"  |  [Right] Toggle  |  type a name + [Enter] to create").c_str(),(float)(pX+34),(float)(y-30),12,CA(t.textDim,0.7f));
+    int top=std::max(0,std::min(s.tagFocus-ROWS/2,(int)g_collections.size()-ROWS)); auto it=g_collections.begin(); std::advance(it,top);
+    for(int r=0;r<ROWS&&it!=g_collections.end();r++,++it){
+        bool foc=(top+r==s.tagFocus),in=it->second.count(key)>0; float ry=(float)(y+r*40);
+        if(foc)D2D().FillRoundRect((float)(pX+30),ry,(float)(pW-60),34,6,6,CA(t.accent,0.22f));
+        D2D().StrokeRoundRect((float)(pX+44),ry+9,16,16,3,3,1.f,CA(t.accent,0.7f));
+        if(in)D2D().FillRoundRect((float)(pX+48),ry+13,8,8,2,2,t.accent);
+        D2D().DrawTextA(it->first.c_str(),(float)(pX+74),ry+7,16,foc?t.text:t.textDim);
+        std::string n=std::to_string(it->second.size()); float nw=D2D().MeasureTextA(n.c_str(),12);
+        D2D().DrawTextA(n.c_str(),(float)(pX+pW-48)-nw,ry+10,12,CA(t.textDim,0.7f));
+    }
+}
+
 // ============================================================================
 // ADD APP OVERLAY
 // ============================================================================
@@ -1198,7 +1988,7 @@ void HandleAddAppOverlay(int sw,int sh,InputAdapter& input){
             CustomApp app; app.name=s.addAppNameBuffer; app.path=s.addAppPathBuffer; app.isWebApp=s.isAddingWebApp;
             int hash=0; for(char c:app.name)hash=hash*31+c;
             app.accentColor=C(80+(hash%175),80+((hash/7)%175),80+((hash/13)%175));
-            s.customApps.push_back(app); SaveProfile(); ShowNotification("App Added",app.name,1);
+            s.customApps.push_back(app); JournalSettings("apps"); ShowNotification("App Added",app.name,1);
             s.currentMode=UIMode::MAIN; PlayConfirmSound();
         } else {ShowNotification("Error","Name and path required",3);PlayErrorSound();}
     }
@@ -1344,7 +2134,7 @@ void HandleProfileEditOverlay(int sw,int sh,InputAdapter& input,float dt){
                 case 2: s.currentMode=UIMode::THEME_SELECT;break;
                 case 5: p.soundEnabled=!p.soundEnabled;g_audio.soundEnabled=p.soundEnabled;break;
                 case 6: p.musicEnabled=!p.musicEnabled;g_audio.musicEnabled=p.musicEnabled;if(!p.musicEnabled)g_audio.StopMusic();break;
-                case 7: SaveProfile();ShowNotification("Saved","",1);s.currentMode=UIMode::MAIN;s.profileEditSlide=0;break;
+                case 7: JournalSettings("config");ShowNotification("Saved","",1);s.currentMode=UIMode::MAIN;s.profileEditSlide=0;break;
             }
         }
         if(s.profileEditFocus==3){if(input.IsMoveLeft()){p.sfxVolume=Clamp(p.sfxVolume-0.1f,0.f,1.f);g_audio.sfxVolume=p.sfxVolume;PlayMoveSound();}if(input.IsMoveRight()){p.sfxVolume=Clamp(p.sfxVolume+0.1f,0.f,1.f);g_audio.sfxVolume=p.sfxVolume;PlayMoveSound();}}
@@ -1701,6 +2491,25 @@ static HWND CreateMainWindow(int w,int h,bool shellMode){
     return hw;
 }
 
+// Renderer churn, averaged over one 30 s window of frames and logged once.
+// Before the gradient cache every gradient call created two COM objects; the
+// line shows both numbers, and how often text was drawn or measured from a
+// cached layout. The first window (startup, posters streaming in) is skipped;
+// the second is the steady state, and after it this costs nothing.
+static void LogRenderStats(float dt){
+    static int window=0; if(window>1)return;
+    static float t=0; static uint64_t frames=0,created=0,grads=0,gradMiss=0,textHit=0,textMiss=0,textTable=0;
+    const auto& st=D2D().LastFrameStats(); frames++; created+=st.comCreated; grads+=st.gradientCalls; gradMiss+=st.gradientMisses;
+    textHit+=st.textHits; textMiss+=st.textMisses; textTable+=st.textTable;
+    if((t+=dt)<30.f)return;
+    if(window++==0){t=0;frames=created=grads=gradMiss=textHit=textMiss=textTable=0;return;}
+    char b[256]; double f=(double)frames;
+    snprintf(b,sizeof(b),"[render] per frame: %.1f objects created; %.1f gradients (%.1f objects uncached), %.2f created; "
+             "text %.1f hits, %.2f misses (%.1f%% hit), %.1f ASCII measures from tables",
+             created/f,grads/f,2*grads/f,gradMiss/f,textHit/f,textMiss/f,textHit+textMiss?100.0*textHit/(textHit+textMiss):0.0,textTable/f);
+    DebugLog(b);
+}
+
 // ============================================================================
 // MAIN  (WinMain)
 // ============================================================================
@@ -1742,7 +2551,12 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
 
     int sw=GetSystemMetrics(SM_CXSCREEN),sh=GetSystemMetrics(SM_CYSCREEN);
     if(sw<=0)sw=1920; if(sh<=0)sh=1080;
-    LoadProfile(); LoadLibraryFromDisk(); LoadCustomAppsFromProfile();
+    Sessions().Load(GetFullPath("profile\\playstats.txt")); Sessions().SetListener(OnSessionEvent);
+    Sizes().Load(GetFullPath("profile\\sizes.txt")); Sizes().SetListener(OnSizeResult);
+    Fingerprints().Load(GetFullPath("profile\\fingerprints.txt")); Fingerprints().SetListener(OnFingerprints);
+    LoadProfile(); LoadTags(); LoadLibraryFromDisk(); LoadCustomAppsFromProfile();
+    if(!Posters().Load(GetFullPath("profile\\art_manifest.txt"),GetFullPath("img\\store")))MigrateLegacyPosters();
+    ReplayProfileJournal();
     InitDefaultApps(); InitPlatformConnections();
 
     // Create main Win32 window + D2D render target
@@ -1765,7 +2579,8 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         std::string af=GetFullPath(g_app.profile.avatarPath);
         if(fs::exists(af)){g_app.profile.avatar=D2D().LoadBitmapA(af.c_str());g_app.profile.hasAvatar=g_app.profile.avatar.Valid();}
     }
-    RefreshLibrary(); LoadGamePosters();
+    LoadGamePosters(); Art().SetListener(OnArtFetched);
+    g_libWatcher.Start(true);   // streams the startup scan in
     g_app.steamProfile=GetSteamProfile(); g_app.steamFriends=GetRealSteamFriends(); LoadSteamAvatar();
 
     InputAdapter input; bool shouldExit=false;
@@ -1789,7 +2604,8 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
 
         UpdateKeyStates();
         s.UpdateThemeTransition(); g_audio.UpdateMusic();
-        UpdateHubSlider(dt); PM().Tick(dt);
+        UpdateHubSlider(dt); ApplyLibraryDeltas(); Art().DispatchCompletions(); Sessions().DispatchCompletions(); Sizes().DispatchCompletions(); Fingerprints().DispatchCompletions(); CheckTagMonth(); LogRenderStats(dt); PM().Tick(dt);
+        if(Journal().WantsCompaction())SaveProfile();
 
         // Plugin input
         {
@@ -1813,7 +2629,7 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         }
 
         input.Update();
-        int totalItems=(int)s.library.size()+1;
+        int totalItems=LibraryRowCount()+1;   // + the "add" tile
 
         // Pending shell actions (resolved next frame)
         if(pendingAction!=ShellAction::NONE){
@@ -1865,6 +2681,9 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
     break;
 }
                 case UIMode::ADD_APP:        HandleAddAppOverlay(sw,sh,input); break;
+                case UIMode::SEARCH:         HandleSearchOverlay(sw,sh,input); break;
+                case UIMode::FILTER:         HandleFilterOverlay(sw,sh,input); break;
+                case UIMode::COLLECTIONS:    HandleCollectionsOverlay(sw,sh,input); break;
                 default: break;
             }
             UpdateAndDrawNotifications(sw,dt); D2D().EndFrame();
@@ -1876,6 +2695,10 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         if(input.IsBG()&&!s.showDeleteWarning) ChangeBackground();
         if(input.IsView()){RefreshTaskList();s.taskFocusIdx=0;s.taskSlideIn=s.taskAnimTime=0;s.currentMode=UIMode::TASK_SWITCHER;PlayConfirmSound();}
         if(input.IsMenu()&&s.isShellMode){s.shellMenuFocus=0;s.shellMenuSlide=0;s.currentMode=UIMode::SHELL_MENU;PlayConfirmSound();}
+        if(input.IsSearch()&&s.barFocused==0&&!s.showDeleteWarning&&!s.library.empty()){OpenSearchOverlay();PlayConfirmSound();}
+        if(input.IsFilter()&&s.barFocused==0&&!s.showDeleteWarning&&!s.library.empty()){OpenFilterOverlay();PlayConfirmSound();}
+        if(input.IsCollections()&&s.barFocused==0&&!s.inTopBar&&!s.showDeleteWarning&&s.focused<LibraryRowCount()){
+            OpenCollectionsOverlay(LibraryAt(s.focused));PlayConfirmSound();}
         if(!s.showDeleteWarning){
             if(input.IsLB()){s.barFocused=(s.barFocused+MENU_COUNT-1)%MENU_COUNT;s.ResetTabFocus();PlayMoveSound();}
             if(input.IsRB()){s.barFocused=(s.barFocused+1)%MENU_COUNT;s.ResetTabFocus();PlayMoveSound();}
@@ -1883,18 +2706,17 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         // Delete warning
         if(s.showDeleteWarning){
             if(input.IsConfirm()){
-                if(s.isFullUninstall&&s.library[s.focused].info.platform=="Steam"&&!s.library[s.focused].info.appId.empty())
-                    ShellExecuteA(nullptr,"open",("steam://uninstall/"+s.library[s.focused].info.appId).c_str(),nullptr,nullptr,SW_SHOWNORMAL);
-                if(s.library[s.focused].hasPoster)D2D().UnloadBitmap(s.library[s.focused].poster);
-                auto nm=s.library[s.focused].info.name;
-                s.library.erase(s.library.begin()+s.focused);
-                SaveProfile(); s.showDeleteWarning=false;
-                s.focused=Clamp(s.focused-1,0,std::max(0,(int)s.library.size()-1));
+                int li=LibraryAt(s.focused); auto& G=s.library[li];
+                if(s.isFullUninstall&&G.platform==PLATFORM_STEAM&&!G.info.appId.empty())
+                    ShellExecuteA(nullptr,"open",("steam://uninstall/"+G.info.appId).c_str(),nullptr,nullptr,SW_SHOWNORMAL);
+                auto nm=G.info.name;
+                RemoveLibraryEntryAt(li);
+                PM().NotifyLibraryChanged(); s.showDeleteWarning=false;
                 PlayConfirmSound(); ShowNotification("Removed",nm,3);
             }
             if(input.IsBack()){s.showDeleteWarning=false;PlayBackSound();}
         } else if(s.inTopBar){
-            if(input.IsMoveDown()){s.inTopBar=false;if(s.barFocused==0)RefreshLibrary();PlayMoveSound();}
+            if(input.IsMoveDown()){s.inTopBar=false;PlayMoveSound();}
             if(input.IsMoveRight()){s.barFocused=(s.barFocused+1)%MENU_COUNT;s.ResetTabFocus();s.inTopBar=true;PlayMoveSound();}
             if(input.IsMoveLeft()){s.barFocused=(s.barFocused+MENU_COUNT-1)%MENU_COUNT;s.ResetTabFocus();s.inTopBar=true;PlayMoveSound();}
         } else {
@@ -1902,17 +2724,18 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
                 if(input.IsMoveDown()){s.focused++;s.showDetails=false;PlayMoveSound();}
                 if(input.IsMoveUp()){if(s.focused==0)s.inTopBar=true;else{s.focused--;s.showDetails=false;}PlayMoveSound();}
                 s.focused=Clamp(s.focused,0,totalItems-1);
-                if(input.IsMoveRight()&&s.focused<(int)s.library.size()){s.showDetails=true;PlayMoveSound();}
+                if(input.IsMoveRight()&&s.focused<LibraryRowCount()){s.showDetails=true;PlayMoveSound();}
                 if(input.IsMoveLeft()){s.showDetails=false;PlayMoveSound();}
-                if(s.focused<(int)s.library.size()){
+                if(input.IsSortCycle()&&!s.library.empty()){
+                    SetLibraryView((s.libraryView+1)%VIEW_COUNT);
+                    ShowNotification("Sort",LibraryViews::Name((LibraryView)s.libraryView),0);PlayMoveSound();}
+                if(s.focused<LibraryRowCount()){
                     if(input.IsChangeArt()){
                         auto img=OpenFilePicker(false); if(!img.empty()){
-                            auto tgt=GetFullPath("img\\"+s.library[s.focused].info.name+".png");
-                            if(s.library[s.focused].hasPoster)D2D().UnloadBitmap(s.library[s.focused].poster);
-                            try{fs::copy_file(img,tgt,fs::copy_options::overwrite_existing);}catch(...){}
-                            s.library[s.focused].poster=D2D().LoadBitmapA(tgt.c_str());
-                            s.library[s.focused].hasPoster=s.library[s.focused].poster.Valid();
-                            SaveProfile();ShowNotification("Art Updated",s.library[s.focused].info.name,1);
+                            auto& G=s.library[LibraryAt(s.focused)];
+                            if(Posters().Ingest(img,G.artKey,false)){ReleaseGamePoster(G);LoadGamePoster(G);JournalArt(G.artKey);
+                                ShowNotification("Art Updated",G.info.name,1);}
+                            else{ShowNotification("Error","Couldn't read that image",3);PlayErrorSound();}
                         }
                     }
                     if(input.IsDeleteDown()){s.holdTimer+=dt;if(s.holdTimer>=HOLD_THRESHOLD){s.showDeleteWarning=true;s.isFullUninstall=true;s.holdTimer=0;PlayErrorSound();}}
@@ -1920,8 +2743,8 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
                 }
                 if(input.IsConfirm()&&!s.showDeleteWarning){
                     PlayConfirmSound();
-                    if(s.focused<(int)s.library.size()){ShowNotification("Launching",s.library[s.focused].info.name,0);LaunchApp(s.library[s.focused].info.exePath);}
-                    else{auto p2=OpenFilePicker(true);if(!p2.empty()){auto nm=fs::path(p2).stem().string();s.library.push_back({{nm,p2,"Manual",""}});SaveProfile();s.focused=(int)s.library.size()-1;ShowNotification("Added",nm,1);}}
+                    if(s.focused<LibraryRowCount()){int li=LibraryAt(s.focused);ShowNotification("Launching",s.library[li].info.name,0);LaunchGame(li);}
+                    else{auto p2=OpenFilePicker(true);if(!p2.empty()){auto nm=fs::path(p2).stem().string();if(AddLibraryEntry({nm,p2,"Manual",""}))PM().NotifyLibraryChanged();s.focused=LibraryRowOf(FindLibraryEntry({nm,p2,"Manual",""}));ShowNotification("Added",nm,1);}}
                 }
             } else if(s.barFocused==3){
                 if(input.IsMoveUp()){if(s.settingsFocusY==0)s.inTopBar=true;else s.settingsFocusY--;PlayMoveSound();}
@@ -1933,7 +2756,7 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
                     switch(idx){
                         case 0: ChangeBackground(); break;
                         case 1: s.profileEditFocus=0;s.profileEditSlide=0;s.currentMode=UIMode::PROFILE_EDIT; break;
-                        case 2: RefreshLibrary(); break;
+                        case 2: g_libWatcher.Reroot(); ShowNotification("Library",std::to_string(s.library.size())+" games, watching "+std::to_string(g_libWatcher.DirectoryCount())+" folders",1); break;
                         case 3: UploadThemeSong(); break;
                         case 4: RemoveThemeSong(); break;
                         case 5: s.themeSelectFocus=s.currentThemeIdx;s.themeSelectSlide=0;s.currentMode=UIMode::THEME_SELECT; break;
@@ -1950,10 +2773,8 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         // Smooth scroll
         s.scrollY=LerpF(s.scrollY,(float)(-s.focused*320)+sh/2.f-135,0.12f);
         s.transAlpha=LerpF(s.transAlpha,0.f,0.3f);
-        for(int i=0;i<(int)s.library.size();i++){
-            float tgt=(!s.inTopBar&&s.showDetails&&i==s.focused&&s.barFocused==0)?1.f:0.f;
-            s.library[i].detailAlpha=LerpF(s.library[i].detailAlpha,tgt,0.15f);
-        }
+        s.cardAnim.Focus((!s.inTopBar&&s.showDetails&&s.barFocused==0&&s.focused<LibraryRowCount())?s.focused:-1);
+        s.cardAnim.Step(0.15f);
 
         // ─── DRAWING ──────────────────────────────────────────────────────────
         D2D().BeginFrame(t.primary);
@@ -1963,28 +2784,37 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         // TAB 0: LIBRARY
         if(s.barFocused==0){
             bool skinHandled=PM().DrawLibraryTab(sw,sh,s.focused,time2);
-            if(!skinHandled) for(int i=0;i<totalItems;i++){
-                float iy=s.scrollY+i*320; if(iy<-300||iy>sh)continue;
+            if(!skinHandled&&!g_filter.Empty()){
+                std::string fl="FILTER  "+g_filter.ToString()+"   "+std::to_string(LibraryRowCount())+" of "+std::to_string(s.library.size())+"  [F] Edit";
+                D2D().DrawTextA(fl.c_str(),120,contentTop-20,13,CA(t.accent,0.75f));
+            }
+            // Rows are 320px apart; only walk the ones on screen.
+            int firstRow=std::max(0,(int)ceilf((-300-s.scrollY)/320)),lastRow=std::min(totalItems-1,(int)floorf((sh-s.scrollY)/320));
+            if(!skinHandled) for(int i=firstRow;i<=lastRow;i++){
+                float iy=s.scrollY+i*320;
                 bool iF=(!s.inTopBar&&i==s.focused);
                 float al=iF?1.f:(s.inTopBar?0.15f:0.25f);
                 QRect_t card={120,iy,480,270};
                 bool skinCard=PM().HasActiveCardSkin();
-                if(i<(int)s.library.size()){
-                    auto& g2=s.library[i];
-                    if(!skinCard&&g2.detailAlpha>0.01f){
-                        float da=g2.detailAlpha;
+                if(i<LibraryRowCount()){
+                    auto& g2=s.library[LibraryAt(i)];
+                    float da=s.cardAnim.Alpha(i);
+                    if(!skinCard&&da>0.01f){
                         D2D().FillRoundRect(card.x+card.width+40,card.y,600*da,card.height,5,5,CA(t.secondary,da*0.9f));
                         if(da>0.8f){
                             float dx=card.x+card.width+80;
                             D2D().DrawTextA("READY TO PLAY",dx,card.y+55,24,CA(t.success,da));
-                            D2D().DrawTextA(g2.info.platform.c_str(),dx,card.y+135,22,CA(t.text,da));
+                            D2D().DrawTextA(PlatformName(g2.platform).c_str(),dx,card.y+135,22,CA(t.text,da));
+                            if(g2.sizeBytes){char sz[32];double mb=g2.sizeBytes/1048576.0;
+                                if(mb>=1024)snprintf(sz,sizeof(sz),"%.1f GB on disk",mb/1024);else snprintf(sz,sizeof(sz),"%.0f MB on disk",mb);
+                                D2D().DrawTextA(sz,dx,card.y+168,16,CA(t.textDim,da*0.8f));}
                             D2D().DrawTextA("[A] LAUNCH",dx,card.y+200,18,CA(t.accent,da));
                         }
                     }
                     DrawGameCard(card,g2,iF,time2);
                     if(!skinCard&&iF&&!s.showDetails){
                         D2D().DrawTextA(g2.info.name.c_str(),card.x+card.width+50,iy+90,40,CA(t.text,al),(DWRITE_FONT_WEIGHT)700);
-                        D2D().DrawTextA(g2.info.platform.c_str(),card.x+card.width+50,iy+140,18,CA(t.textDim,al*0.7f));
+                        D2D().DrawTextA(PlatformName(g2.platform).c_str(),card.x+card.width+50,iy+140,18,CA(t.textDim,al*0.7f));
                         if(s.holdTimer>0)D2D().FillRect(card.x+card.width+50,iy+170,(s.holdTimer/HOLD_THRESHOLD)*200,4,t.danger);
                     }
                 } else {
@@ -2005,7 +2835,7 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
         else if(s.barFocused==3){
             float tsx=sw/2.f-490,tsy=contentTop+60,tw2=270,th2=165,tgap=18;
             struct SI{const char* i,*t2;D2D1_COLOR_F c;};
-            SI items[]={{"B","Background",t.accent},{"P","Profile",PURPLE_COL},{"R","Refresh",t.success},{"M","Upload Music",C(100,200,255)},{"x","Remove Music",C(255,100,100)},{"T","Theme",ORANGE_COL},{"S","Skin/Plugin",C(200,100,255)},{"?","About",GRAY_COL},{"Q","Exit",t.danger}};
+            SI items[]={{"B","Background",t.accent},{"P","Profile",PURPLE_COL},{"L","Library",t.success},{"M","Upload Music",C(100,200,255)},{"x","Remove Music",C(255,100,100)},{"T","Theme",ORANGE_COL},{"S","Skin/Plugin",C(200,100,255)},{"?","About",GRAY_COL},{"Q","Exit",t.danger}};
             int fi=s.settingsFocusY*3+s.settingsFocusX;
             for(int r=0;r<3;r++) for(int c2=0;c2<3;c2++){
                 int idx=r*3+c2;
@@ -2023,7 +2853,7 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
             D2D().FillRoundRect(bx3,by3,600,300,8,8,t.secondary);
             D2D().StrokeRoundRect(bx3,by3,600,300,8,8,2.f,s.isFullUninstall?t.danger:t.warning);
             D2D().DrawTextA(s.isFullUninstall?"FULL UNINSTALL":"REMOVE FROM LIST",bx3+150,by3+50,28,s.isFullUninstall?t.danger:t.warning,(DWRITE_FONT_WEIGHT)700);
-            D2D().DrawTextA(s.library[s.focused].info.name.c_str(),bx3+100,by3+100,20,t.text);
+            D2D().DrawTextA(s.library[LibraryAt(s.focused)].info.name.c_str(),bx3+100,by3+100,20,t.text);
             D2D().DrawTextA("Confirm [A] or [B] cancel",bx3+180,by3+180,18,t.textDim);
         }
         if(s.transAlpha>0.01f)D2D().FillRect(0,110,(float)sw,(float)(sh-180),CA(t.primary,s.transAlpha));
@@ -2037,10 +2867,11 @@ int WINAPI WinMain(HINSTANCE,HINSTANCE,LPSTR,int){
     if(g_app.bgTexture.Valid())D2D().UnloadBitmap(g_app.bgTexture);
     if(g_app.steamAvatarTex.Valid())D2D().UnloadBitmap(g_app.steamAvatarTex);
     for(auto& app:g_app.customApps)if(app.hasIcon)D2D().UnloadBitmap(app.icon);
-    for(auto& g2:g_app.library)if(g2.hasPoster)D2D().UnloadBitmap(g2.poster);
+    for(auto& g2:g_app.library)ReleaseGamePoster(g2);
     if(g_app.profile.hasAvatar)D2D().UnloadBitmap(g_app.profile.avatar);
     for(int i=0;i<3;i++)if(g_app.hubSlider.artCovers[i].Valid())D2D().UnloadBitmap(g_app.hubSlider.artCovers[i]);
 
+    g_libWatcher.Stop(); Art().Stop(); Sessions().Stop(); Sizes().Stop(); Fingerprints().Stop(); Journal().Close();
     g_audio.Cleanup(); UnloadSkinPlugins(); D2D().Shutdown(); StopInputMonitoring();
 
     if(g_app.isShellMode)LaunchExplorer();
@@ -122,7 +122,9 @@ typedef struct D2DPluginAPI {
     float (*MeasureTextW) (const wchar_t* text, float size, int weight);
 
     // ── Text — UTF-8 convenience wrappers ─────────────────────────────────────
-    // Internally converts to UTF-16 and calls DrawTextW/MeasureTextW.
+    // Same rendering as the W calls. Printable-ASCII measurement is a table
+    // sum, and repeated strings reuse cached layouts, so calling these every
+    // frame is cheap.
     void  (*DrawTextA)    (const char* text, float x, float y, float size,
                            D2DColor c, int weight);
     float (*MeasureTextA) (const char* text, float size, int weight);
@@ -173,6 +175,14 @@ typedef struct QShellGameInfo {
     long long   last_played;   // Unix timestamp of last play (0 if unknown)
 } QShellGameInfo;
 
+// Session tracker figures for one game (QShellHostAPI::GetGameStats).
+typedef struct QShellGameStats {
+    long long playtime_sec;    // total, including a session still running
+    long long last_played;     // Unix timestamp the latest session started
+    long long running_since;   // Unix timestamp, 0 if not running
+    int       session_count;   // finished sessions
+} QShellGameStats;
+
 
 // ============================================================================
 //  QShellTheme  — current host UI colour palette snapshot (D2DColor)
@@ -273,6 +283,36 @@ typedef struct QShellHostAPI {
     // ── Shell mode ────────────────────────────────────────────────────────────
     bool (*IsShellMode)(void);
 
+    // ── Library search ────────────────────────────────────────────────────────
+    // Fuzzy, ranked best first. Writes up to maxResults library indices to
+    // outIdx and returns how many were written.
+    int  (*SearchLibrary)(const char* query, int* outIdx, int maxResults);
+
+    // ── Library views ─────────────────────────────────────────────────────────
+    // Game indices everywhere in this table are rows of the active view.
+    // 0=Library order 1=A-Z 2=Recently played 3=Most played 4=By platform
+    // 5=Recently added 6=Largest first. GetLibraryViewName returns NULL past
+    // the last view.
+    int         (*GetLibraryView)    (void);
+    void        (*SetLibraryView)    (int view);
+    const char* (*GetLibraryViewName)(int view);
+
+    // ── Play sessions ─────────────────────────────────────────────────────────
+    // False if the game has never been launched from the shell.
+    bool (*GetGameStats)(int index, QShellGameStats* out);
+
+    // ── Tags and filters ──────────────────────────────────────────────────────
+    // Filter syntax: "tag" or "+tag" = must have, "|tag" = any of these,
+    // "-tag" = must not have; "" clears. Automatic tags are "platform:<name>",
+    // "drive:<letter>", "played:month" and "size:small/medium/large/huge"
+    // (under 1, 10, 50 GB, and above); anything else is a user collection.
+    // While a filter is set, GetGameCount and every index above cover only
+    // the matching games. GetGameTags writes a comma-separated list and
+    // returns its full length (excluding the terminator).
+    void        (*SetLibraryFilter)(const char* expr);
+    const char* (*GetLibraryFilter)(void);
+    int         (*GetGameTags)     (int index, char* buf, int bufLen);
+
 } QShellHostAPI;
 
 
@@ -314,6 +354,11 @@ typedef struct QShellPluginDesc {
     int  (*GetContextMenuItems)(int gameIdx, const char** items, int maxItems);
     void (*OnContextMenuAction)(int gameIdx, int itemIdx);
 
+    // ── Artwork ───────────────────────────────────────────────────────────────
+    // Width / height of this skin's game card (e.g. 600.f/900.f for portrait
+    // covers). Local art is picked to fit it. 0 = host default (480x270).
+    float posterAspect;
+
 } QShellPluginDesc;
 
 
@@ -0,0 +1,78 @@
+// ============================================================================
+// SCAN_INDEX.CPP - Q-SHELL v3.0
+//
+// File format (profile\scan_index.txt), one manifest per line after a header:
+//   QSCAN1
+//   manifest|size|mtime|resolved|name|exePath|platform|appId
+// ============================================================================
+
+#include "scan_index.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static const char* const SCAN_INDEX_MAGIC = "QSCAN1";
+
+bool ScanIndex::Load(const std::string& path) {
+    m_entries.clear();
+    std::ifstream f(path);
+    if (!f) return false;
+
+    std::string line;
+    if (!std::getline(f, line) || line != SCAN_INDEX_MAGIC) return false;
+
+    while (std::getline(f, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string manifest, size, mtime, ok, name, exe, platform, appId;
+        std::getline(ss, manifest, '|'); std::getline(ss, size, '|');
+        std::getline(ss, mtime, '|');    std::getline(ss, ok, '|');
+        std::getline(ss, name, '|');     std::getline(ss, exe, '|');
+        std::getline(ss, platform, '|'); std::getline(ss, appId, '|');
+        if (manifest.empty()) continue;
+
+        ScanIndexEntry e;
+        e.manifest = manifest;
+        try { e.size = std::stoull(size); e.mtime = std::stoll(mtime); } catch (...) { continue; }
+        e.resolved = (ok == "1");
+        e.game     = { name, exe, platform, appId };
+        m_entries[e.manifest] = std::move(e);
+    }
+    return true;
+}
+
+bool ScanIndex::Save(const std::string& path) const {
+    try { fs::create_directories(fs::path(path).parent_path()); } catch (...) {}
+
+    // Write to a temp file first so a crash mid-save never leaves a torn index.
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f) return false;
+        f << SCAN_INDEX_MAGIC << "\n";
+        for (auto& [k, e] : m_entries) {
+            f << e.manifest << "|" << e.size << "|" << e.mtime << "|" << (e.resolved ? 1 : 0) << "|"
+              << e.game.name << "|" << e.game.exePath << "|" << e.game.platform << "|" << e.game.appId << "\n";
+        }
+        if (!f) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    return !ec;
+}
+
+const ScanIndexEntry* ScanIndex::Find(const std::string& manifest,
+                                      uint64_t size, int64_t mtime) const {
+    auto it = m_entries.find(manifest);
+    if (it == m_entries.end()) return nullptr;
+    if (it->second.size != size || it->second.mtime != mtime) return nullptr;
+    return &it->second;
+}
+
+void ScanIndex::Put(ScanIndexEntry e) {
+    std::string key = e.manifest;
+    m_entries[key] = std::move(e);
+}
@@ -0,0 +1,48 @@
+// ============================================================================
+// SCAN_INDEX.HPP - Q-SHELL v3.0
+// Persistent manifest -> GameInfo cache for the library scanner.
+//
+// One record per store manifest (.acf / .item): its path, size and mtime plus
+// whatever the scanner resolved from it. A refresh only re-parses manifests
+// whose size or mtime moved; records for manifests that vanished are dropped
+// when the index is rebuilt from the current listing.
+// ============================================================================
+
+#pragma once
+
+#include "game_finder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+struct ScanIndexEntry {
+    std::string manifest;
+    uint64_t    size     = 0;
+    int64_t     mtime    = 0;      // file_time_type ticks
+    bool        resolved = false;  // false = manifest parsed but yields no game
+    GameInfo    game;
+};
+
+class ScanIndex {
+public:
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+    // Returns the cached record only if size and mtime both still match.
+    const ScanIndexEntry* Find(const std::string& manifest,
+                               uint64_t size, int64_t mtime) const;
+
+    void Put(ScanIndexEntry e);
+    void Erase(const std::string& manifest) { m_entries.erase(manifest); }
+    void Clear()                            { m_entries.clear(); }
+    size_t Size() const                     { return m_entries.size(); }
+
+    const std::unordered_map<std::string, ScanIndexEntry>& Entries() const { return m_entries; }
+
+private:
+    std::unordered_map<std::string, ScanIndexEntry> m_entries;
+};
+
+// Default location, relative to the exe directory (the working directory).
+static const char* const SCAN_INDEX_FILE = "profile\\scan_index.txt";
@@ -0,0 +1,144 @@
+// ============================================================================
+// SEARCH_INDEX.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "search_index.hpp"
+
+#include <algorithm>
+
+// ─── Normalisation ───────────────────────────────────────────────────────────
+
+std::string SearchIndex::Normalize(std::string_view s) {
+    std::string out;
+    Normalize(s, out);
+    return out;
+}
+
+void SearchIndex::Normalize(std::string_view s, std::string& out) {
+    out.clear();
+    out.reserve(s.size());
+    for (char c : s) {
+        unsigned char u = (unsigned char)c;
+        if (u >= 'A' && u <= 'Z') out += (char)(u + 32);
+        else if ((u >= 'a' && u <= 'z') || (u >= '0' && u <= '9')) out += (char)u;
+        else if (!out.empty() && out.back() != ' ') out += ' ';
+    }
+    while (!out.empty() && out.back() == ' ') out.pop_back();
+}
+
+// Grams are taken per word over " word" (one leading pad), so every word
+// contributes a start-of-word gram and grams never span two words.
+void SearchIndex::Trigrams(const std::string& norm, std::vector<uint32_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < norm.size()) {
+        size_t j = norm.find(' ', i);
+        if (j == std::string::npos) j = norm.size();
+        uint32_t a = ' ', b = ' ';
+        for (size_t k = i; k < j; k++) {
+            uint32_t c = (unsigned char)norm[k];
+            out.push_back(a << 16 | b << 8 | c);
+            a = b; b = c;
+        }
+        i = j + 1;
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// ─── Maintenance ─────────────────────────────────────────────────────────────
+
+void SearchIndex::Clear() {
+    m_docs.clear(); m_free.clear(); m_byId.clear(); m_postings.clear();
+}
+
+void SearchIndex::Add(uint32_t id, std::string_view name, std::string_view platform) {
+    Remove(id);
+    uint32_t slot;
+    if (!m_free.empty()) { slot = m_free.back(); m_free.pop_back(); }
+    else                 { slot = (uint32_t)m_docs.size(); m_docs.emplace_back(); }
+
+    Doc& d = m_docs[slot];
+    d.id   = id;
+    d.live = true;
+    d.text = Normalize(name);
+    std::string plat = Normalize(platform);
+    if (!plat.empty()) d.text += (d.text.empty() ? "" : " ") + plat;
+
+    std::vector<uint32_t> grams;
+    Trigrams(d.text, grams);
+    d.grams = (uint16_t)std::min<size_t>(grams.size(), 0xFFFF);
+    for (uint32_t g : grams) m_postings[g].push_back(slot);
+    m_byId[id] = slot;
+}
+
+void SearchIndex::Remove(uint32_t id) {
+    auto it = m_byId.find(id);
+    if (it == m_byId.end()) return;
+    uint32_t slot = it->second;
+    m_byId.erase(it);
+
+    Doc& d = m_docs[slot];
+    std::vector<uint32_t> grams;
+    Trigrams(d.text, grams);
+    for (uint32_t g : grams) {
+        auto p = m_postings.find(g);
+        if (p == m_postings.end()) continue;
+        auto& v = p->second;
+        auto  s = std::find(v.begin(), v.end(), slot);
+        if (s != v.end()) { *s = v.back(); v.pop_back(); }
+        if (v.empty()) m_postings.erase(p);
+    }
+    d.live = false;
+    d.text.clear();
+    m_free.push_back(slot);
+}
+
+// ─── Query ───────────────────────────────────────────────────────────────────
+
+void SearchIndex::Query(std::string_view query, size_t limit, std::vector<SearchHit>& out) const {
+    out.clear();
+    Normalize(query, m_qtext);
+    const std::string& q = m_qtext;
+    if (q.empty() || limit == 0) return;
+
+    Trigrams(q, m_qgrams);
+    m_counts.assign(m_docs.size(), 0);
+    m_touched.clear();
+    m_ranked.clear();
+    for (uint32_t g : m_qgrams) {
+        auto p = m_postings.find(g);
+        if (p == m_postings.end()) continue;
+        for (uint32_t slot : p->second)
+            if (m_counts[slot]++ == 0) m_touched.push_back(slot);
+    }
+
+    // Require a third of the query's grams (at least one) so one shared
+    // gram doesn't drag in half the library for a long query.
+    size_t qn   = m_qgrams.size();
+    size_t need = std::max<size_t>(1, qn / 3);
+    for (uint32_t slot : m_touched) {
+        const Doc& d = m_docs[slot];
+        size_t m = m_counts[slot];
+        if (m < need) continue;
+        float score = 2.f * (float)m / (float)(qn + d.grams);
+        size_t pos = d.text.find(q);
+        if (pos == 0)                                      score += 0.5f;   // prefix
+        else if (pos != std::string::npos && d.text[pos - 1] == ' ') score += 0.35f;   // word start
+        else if (pos != std::string::npos)                 score += 0.2f;
+        m_ranked.push_back({ slot, score });
+    }
+
+    // Equal scores fall back to the shorter, then alphabetically first, name.
+    auto better = [this](const SearchHit& a, const SearchHit& b) {
+        if (a.score != b.score) return a.score > b.score;
+        const std::string& ta = m_docs[a.id].text;
+        const std::string& tb = m_docs[b.id].text;
+        if (ta.size() != tb.size()) return ta.size() < tb.size();
+        return ta < tb;
+    };
+    size_t n = std::min(limit, m_ranked.size());
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + n, m_ranked.end(), better);
+    out.reserve(n);
+    for (size_t i = 0; i < n; i++) out.push_back({ m_docs[m_ranked[i].id].id, m_ranked[i].score });
+}
@@ -0,0 +1,63 @@
+// ============================================================================
+// SEARCH_INDEX.HPP - Q-SHELL v3.0
+// Trigram fuzzy-search index over the library.
+//
+// Each entry's name and platform are normalised (lower-case ASCII letters
+// and digits, everything else a single space) and cut into overlapping
+// three-character grams, with word starts padded so "hal" ranks Half-Life
+// above Chalice. A query counts shared grams per candidate through the
+// posting lists and ranks by Dice overlap, with a bonus for a prefix or
+// substring match, so typos and missing words still find the game.
+//
+// Entries are keyed by a caller-chosen stable id (not a library slot), and
+// Add / Remove touch only that entry's postings, so library deltas keep the
+// index current without a rebuild.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct SearchHit {
+    uint32_t id;
+    float    score;   // 0..~1.5, higher is better
+};
+
+class SearchIndex {
+public:
+    void Clear();
+    void Add(uint32_t id, std::string_view name, std::string_view platform);
+    void Remove(uint32_t id);
+    size_t Size() const { return m_byId.size(); }
+
+    // Best matches first, at most limit. Empty query = no hits.
+    void Query(std::string_view query, size_t limit, std::vector<SearchHit>& out) const;
+
+    static std::string Normalize(std::string_view s);
+    static void        Normalize(std::string_view s, std::string& out);   // reuses out's buffer
+
+private:
+    struct Doc {
+        uint32_t    id    = 0;
+        uint16_t    grams = 0;   // distinct trigram count
+        bool        live  = false;
+        std::string text;        // normalised name + platform
+    };
+    static void Trigrams(const std::string& norm, std::vector<uint32_t>& out);   // distinct, sorted
+
+    std::vector<Doc>                                  m_docs;       // slot -> doc
+    std::vector<uint32_t>                             m_free;       // recycled slots
+    std::unordered_map<uint32_t, uint32_t>            m_byId;       // id -> slot
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings; // trigram -> slots
+
+    // Query scratch, reused so a keystroke allocates nothing once warm.
+    mutable std::string           m_qtext;
+    mutable std::vector<uint16_t> m_counts;
+    mutable std::vector<uint32_t> m_touched;
+    mutable std::vector<uint32_t> m_qgrams;
+    mutable std::vector<SearchHit> m_ranked;   // id field holds the slot here
+};
@@ -0,0 +1,326 @@
+// ============================================================================
+// SESSION_TRACKER.CPP - Q-SHELL v3.0
+//
+// playstats.txt:
+//   QSTATS1
+//   H|<heartbeat>
+//   S|<game key hex>|<last played>|<playtime>|<sessions>
+//   R|<game key hex>|<pid>|<creation filetime>|<start>
+// ============================================================================
+
+#include "session_tracker.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+void DebugLog(const std::string& msg);   // qshell.cpp
+
+static const ULONG_PTR KEY_STOP  = ~(ULONG_PTR)0;
+static const ULONG_PTR KEY_SAVE  = ~(ULONG_PTR)1;
+static const DWORD     HEARTBEAT_MS = 60 * 1000;
+
+SessionTracker& Sessions() {
+    static SessionTracker tracker;
+    return tracker;
+}
+
+static long long Now() { return (long long)time(nullptr); }
+
+static uint64_t CreationTime(HANDLE process) {
+    FILETIME c, e, k, u;
+    if (!GetProcessTimes(process, &c, &e, &k, &u)) return 0;
+    return (uint64_t)c.dwHighDateTime << 32 | c.dwLowDateTime;
+}
+
+// ─── Attach / release ────────────────────────────────────────────────────────
+
+// Fallback wait: reports the exit the same way a job would.
+struct ExitWait { HANDLE port; uint32_t id; };
+static VOID CALLBACK OnProcessExit(PVOID param, BOOLEAN) {
+    auto* w = (ExitWait*)param;
+    PostQueuedCompletionStatus(w->port, JOB_OBJECT_MSG_ACTIVE_PROCESS_ZERO, w->id, nullptr);
+}
+
+bool SessionTracker::Attach(uint32_t id, Session& s) {
+    HANDLE process = (HANDLE)s.process;
+    HANDLE job     = CreateJobObjectA(nullptr, nullptr);
+    if (job) {
+        JOBOBJECT_ASSOCIATE_COMPLETION_PORT_INFORMATION acp = {};
+        acp.CompletionKey  = (PVOID)(ULONG_PTR)id;
+        acp.CompletionPort = (HANDLE)m_port;
+        // Deliberately no KILL_ON_JOB_CLOSE: closing the shell never ends a game.
+        if (SetInformationJobObject(job, JobObjectAssociateCompletionPortInformation, &acp, sizeof(acp)) &&
+            AssignProcessToJobObject(job, process)) {
+            s.job = job;
+            // It may have exited between launch and assignment: then the
+            // job never sees an active process and never reports zero.
+            if (WaitForSingleObject(process, 0) == WAIT_OBJECT_0) return false;
+            CloseHandle(process);
+            s.process = nullptr;
+            return true;
+        }
+        CloseHandle(job);
+    }
+    if (WaitForSingleObject(process, 0) == WAIT_OBJECT_0) return false;
+    s.waitCtx = new ExitWait{ (HANDLE)m_port, id };
+    HANDLE wait = nullptr;
+    if (!RegisterWaitForSingleObject(&wait, process, OnProcessExit, s.waitCtx, INFINITE,
+                                     WT_EXECUTEONLYONCE | WT_EXECUTEINWAITTHREAD))
+        return false;
+    s.wait = wait;
+    return true;
+}
+
+void SessionTracker::Release(Session& s) {
+    // Blocks until a callback in flight has finished with waitCtx.
+    if (s.wait)    UnregisterWaitEx((HANDLE)s.wait, INVALID_HANDLE_VALUE);
+    if (s.job)     CloseHandle((HANDLE)s.job);
+    if (s.process) CloseHandle((HANDLE)s.process);
+    delete (ExitWait*)s.waitCtx;
+    s.wait = s.job = s.process = s.waitCtx = nullptr;
+}
+
+// ─── Sessions ────────────────────────────────────────────────────────────────
+
+void SessionTracker::Emit(uint64_t game, bool started) {
+    SessionEvent e;
+    e.game    = game;
+    e.started = started;
+    e.stats   = m_stats[game];
+    std::lock_guard<std::mutex> l(m_doneMutex);
+    m_done.push_back(e);
+}
+
+void SessionTracker::Track(uint64_t game, void* process) {
+    if (!process) return;
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (!m_port) { l.unlock(); CloseHandle((HANDLE)process); return; }
+
+    uint32_t id = m_nextId++;
+    Session& s  = m_sessions[id];
+    s.game    = game;
+    s.process = process;
+    s.pid     = GetProcessId((HANDLE)process);
+    s.created = CreationTime((HANDLE)process);
+    s.start   = Now();
+
+    PlayStats& st = m_stats[game];
+    st.lastPlayed = s.start;
+    if (!st.runningSince) st.runningSince = s.start;
+    Emit(game, true);
+
+    if (!Attach(id, s)) {
+        // Already gone (a launcher that handed off and quit): nothing to follow.
+        Release(s);
+        m_sessions.erase(id);
+        st.runningSince = 0;
+        for (auto& [oid, o] : m_sessions)
+            if (o.game == game && (!st.runningSince || o.start < st.runningSince)) st.runningSince = o.start;
+        Emit(game, false);
+    }
+    l.unlock();
+    PostQueuedCompletionStatus((HANDLE)m_port, 0, KEY_SAVE, nullptr);
+}
+
+void SessionTracker::Touch(uint64_t game) {
+    std::lock_guard<std::mutex> l(m_mutex);
+    m_stats[game].lastPlayed = Now();
+    Emit(game, true);
+    if (m_port) PostQueuedCompletionStatus((HANDLE)m_port, 0, KEY_SAVE, nullptr);
+}
+
+void SessionTracker::Finish(uint32_t id, long long end) {
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_sessions.find(id);
+    if (it == m_sessions.end()) return;
+    Session& s = it->second;
+    uint64_t game = s.game;
+
+    PlayStats& st = m_stats[game];
+    st.playtime += std::max(0LL, end - s.start);
+    st.sessions++;
+    Release(s);
+    m_sessions.erase(it);
+
+    st.runningSince = 0;
+    for (auto& [oid, o] : m_sessions)
+        if (o.game == game && (!st.runningSince || o.start < st.runningSince)) st.runningSince = o.start;
+    Emit(game, false);
+}
+
+bool SessionTracker::Find(uint64_t game, PlayStats& out) const {
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_stats.find(game);
+    if (it == m_stats.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void SessionTracker::Rekey(uint64_t from, uint64_t to) {
+    if (from == to) return;
+    std::lock_guard<std::mutex> l(m_mutex);
+    auto it = m_stats.find(from);
+    if (it == m_stats.end()) return;
+    PlayStats  old = it->second;
+    m_stats.erase(it);
+    PlayStats& st  = m_stats[to];
+    st.lastPlayed = std::max(st.lastPlayed, old.lastPlayed);
+    st.playtime  += old.playtime;
+    st.sessions  += old.sessions;
+    if (old.runningSince && (!st.runningSince || old.runningSince < st.runningSince)) st.runningSince = old.runningSince;
+    for (auto& [id, s] : m_sessions)
+        if (s.game == from) s.game = to;
+    if (m_port) PostQueuedCompletionStatus((HANDLE)m_port, 0, KEY_SAVE, nullptr);
+}
+
+void SessionTracker::DispatchCompletions() {
+    std::vector<SessionEvent> done;
+    {
+        std::lock_guard<std::mutex> l(m_doneMutex);
+        if (m_done.empty()) return;
+        done.swap(m_done);
+    }
+    if (m_listener) for (auto& e : done) m_listener(e);
+}
+
+// ─── Thread ──────────────────────────────────────────────────────────────────
+
+void SessionTracker::Run() {
+    for (;;) {
+        DWORD timeout;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            timeout = m_sessions.empty() ? INFINITE : HEARTBEAT_MS;
+        }
+        DWORD       msg = 0;
+        ULONG_PTR   key = 0;
+        LPOVERLAPPED ov = nullptr;
+        if (!GetQueuedCompletionStatus((HANDLE)m_port, &msg, &key, &ov, timeout)) {
+            if (!ov) Save();   // timed out: heartbeat
+            continue;
+        }
+        if (key == KEY_STOP) return;
+        if (key == KEY_SAVE) { Save(); continue; }
+        // Job messages carry the session id as the key; the rest (new
+        // process, one process exiting) are of no interest.
+        if (msg == JOB_OBJECT_MSG_ACTIVE_PROCESS_ZERO) {
+            Finish((uint32_t)key, Now());
+            Save();
+        }
+    }
+}
+
+// ─── Persistence ─────────────────────────────────────────────────────────────
+
+void SessionTracker::Save() {
+    std::ostringstream o;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_heartbeat = Now();
+        o << "QSTATS1\nH|" << m_heartbeat << "\n";
+        char key[17];
+        for (auto& [game, st] : m_stats) {
+            snprintf(key, sizeof(key), "%016" PRIx64, game);
+            o << "S|" << key << "|" << st.lastPlayed << "|" << st.playtime << "|" << st.sessions << "\n";
+        }
+        for (auto& [id, s] : m_sessions) {
+            snprintf(key, sizeof(key), "%016" PRIx64, s.game);
+            o << "R|" << key << "|" << s.pid << "|" << s.created << "|" << s.start << "\n";
+        }
+    }
+    if (m_path.empty()) return;
+    std::string tmp = m_path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        f << o.str();
+        if (!f) return;
+    }
+    if (!MoveFileExA(tmp.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING)) DeleteFileA(tmp.c_str());
+}
+
+void SessionTracker::Load(const std::string& path) {
+    if (m_port) return;
+    m_path = path;
+    m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+    if (!m_port) { DebugLog("[sessions] no completion port; playtime not tracked"); return; }
+
+    struct Running { uint64_t game; uint32_t pid; uint64_t created; long long start; };
+    std::vector<Running> running;
+    {
+        std::ifstream f(path);
+        std::string line;
+        if (std::getline(f, line) && line == "QSTATS1") {
+            while (std::getline(f, line)) {
+                std::vector<std::string> p;
+                std::stringstream ss(line);
+                for (std::string t; std::getline(ss, t, '|');) p.push_back(t);
+                try {
+                    if (p.size() == 2 && p[0] == "H") m_heartbeat = std::stoll(p[1]);
+                    else if (p.size() == 5 && p[0] == "S") {
+                        PlayStats& st = m_stats[std::stoull(p[1], nullptr, 16)];
+                        st.lastPlayed = std::stoll(p[2]);
+                        st.playtime   = std::stoll(p[3]);
+                        st.sessions   = (uint32_t)std::stoul(p[4]);
+                    } else if (p.size() == 5 && p[0] == "R")
+                        running.push_back({ std::stoull(p[1], nullptr, 16), (uint32_t)std::stoul(p[2]),
+                                            std::stoull(p[3]), std::stoll(p[4]) });
+                } catch (...) {}   // one bad line loses one entry
+            }
+        }
+    }
+
+    int reattached = 0;
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        for (auto& r : running) {
+            HANDLE h = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_QUOTA | PROCESS_TERMINATE,
+                                   FALSE, r.pid);
+            if (!h) h = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, r.pid);
+            bool same = h && CreationTime(h) == r.created;
+            uint32_t id = m_nextId++;
+            Session& s  = m_sessions[id];
+            s.game = r.game; s.pid = r.pid; s.created = r.created; s.start = r.start;
+            PlayStats& st = m_stats[r.game];
+            if (same) {
+                s.process = h;
+                if (Attach(id, s)) {
+                    if (!st.runningSince || s.start < st.runningSince) st.runningSince = s.start;
+                    reattached++;
+                    continue;
+                }
+            } else if (h) {
+                CloseHandle(h);   // pid was reused by something else
+            }
+            // Ended while we were down: credit it up to the last heartbeat.
+            st.playtime += std::max(0LL, std::max(m_heartbeat, r.start) - r.start);
+            st.sessions++;
+            Release(s);
+            m_sessions.erase(id);
+        }
+    }
+    if (!running.empty())
+        DebugLog("[sessions] " + std::to_string(reattached) + " of " + std::to_string(running.size()) +
+                 " running sessions re-attached");
+    m_thread = std::thread(&SessionTracker::Run, this);
+    PostQueuedCompletionStatus((HANDLE)m_port, 0, KEY_SAVE, nullptr);
+}
+
+void SessionTracker::Stop() {
+    if (!m_port) return;
+    PostQueuedCompletionStatus((HANDLE)m_port, 0, KEY_STOP, nullptr);
+    if (m_thread.joinable()) m_thread.join();
+    Save();   // final heartbeat; running sessions stay listed for re-attach
+    std::lock_guard<std::mutex> l(m_mutex);
+    for (auto& [id, s] : m_sessions) Release(s);
+    m_sessions.clear();
+    CloseHandle((HANDLE)m_port);
+    m_port = nullptr;
+}
@@ -0,0 +1,117 @@
+// ============================================================================
+// SESSION_TRACKER.HPP - Q-SHELL v3.0
+// Play sessions and per-game playtime.
+//
+// A launched game's process is put in its own job object, so everything it
+// spawns (launcher -> game, game -> crash reporter) stays in the session, and
+// the job reports through one I/O completion port when its last process
+// exits. One tracker thread blocks on that port: no polling, no handle per
+// thread, and the 64-handle WaitForMultipleObjects ceiling never applies.
+// A process that can't be put in a job (elevated, say) is waited on with a
+// thread-pool wait that posts to the same port. A game that re-launches
+// itself through its store client leaves the job with that hand-off, so
+// its session ends when the process we started does.
+//
+// Stats live in profile\playstats.txt, keyed by the caller's 64-bit game key.
+// Running sessions are written there too, with the process id and creation
+// time, so after a shell restart the tracker re-attaches to games that are
+// still running. Games that exited while the shell was down are credited up
+// to the last heartbeat (written once a minute while anything is running).
+//
+// Like ArtFetcher, changes are queued and handed to the listener from
+// DispatchCompletions() on the UI thread.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct PlayStats {
+    long long lastPlayed   = 0;   // Unix seconds; start of the latest session
+    long long playtime     = 0;   // finished sessions, seconds
+    long long runningSince = 0;   // start of the oldest running session, 0 = not running
+    uint32_t  sessions     = 0;   // finished sessions
+};
+
+struct SessionEvent {
+    uint64_t  game = 0;
+    bool      started = false;    // false: a session ended
+    PlayStats stats;              // after the change
+};
+
+class SessionTracker {
+public:
+    using Listener = std::function<void(const SessionEvent&)>;
+
+    SessionTracker() = default;
+    ~SessionTracker() { Stop(); }
+    SessionTracker(const SessionTracker&)            = delete;
+    SessionTracker& operator=(const SessionTracker&) = delete;
+
+    // Reads the stats file, re-attaches to sessions that are still running
+    // and starts the tracker thread. A missing file is an empty history.
+    void Load(const std::string& path);
+
+    // Starts a session for game. process is a Win32 process HANDLE with at
+    // least SYNCHRONIZE access; the tracker takes ownership of it.
+    void Track(uint64_t game, void* process);
+
+    // A launch with no process to follow (a store URL, say): only lastPlayed
+    // moves. Delivered as a start whose stats show nothing running.
+    void Touch(uint64_t game);
+
+    bool Find(uint64_t game, PlayStats& out) const;
+
+    // Moves everything recorded for from onto to (a library entry whose key
+    // changed): stats are merged and running sessions follow.
+    void Rekey(uint64_t from, uint64_t to);
+
+    // UI thread: delivers session starts and ends to the listener.
+    void SetListener(Listener l) { m_listener = std::move(l); }
+    void DispatchCompletions();
+
+    // Writes a final heartbeat and stops the thread. Running games keep
+    // running and are picked up again by the next Load.
+    void Stop();
+
+private:
+    struct Session {
+        uint64_t  game    = 0;
+        uint32_t  pid     = 0;
+        uint64_t  created = 0;         // process creation FILETIME, guards against pid reuse
+        long long start   = 0;
+        void*     job     = nullptr;
+        void*     process = nullptr;   // kept only for the fallback wait
+        void*     wait    = nullptr;
+        void*     waitCtx = nullptr;   // owned; see Attach
+    };
+
+    void Run();
+    bool Attach(uint32_t id, Session& s);   // job, or fallback wait; false if the process is gone
+    void Finish(uint32_t id, long long end);
+    void Release(Session& s);
+    void Save();
+    void Emit(uint64_t game, bool started);   // m_mutex held
+
+    std::string                             m_path;
+    void*                                   m_port = nullptr;
+    std::thread                             m_thread;
+    long long                               m_heartbeat = 0;
+
+    mutable std::mutex                      m_mutex;
+    std::unordered_map<uint64_t, PlayStats> m_stats;      // game -> stats
+    std::unordered_map<uint32_t, Session>   m_sessions;   // id -> running session
+    uint32_t                                m_nextId = 1;
+
+    std::mutex                m_doneMutex;
+    std::vector<SessionEvent> m_done;
+    Listener                  m_listener;
+};
+
+SessionTracker& Sessions();
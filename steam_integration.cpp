@@ -4,6 +4,7 @@
 
 #include "steam_integration.hpp"
 #include "d2d_renderer.hpp"
+#include "vdf_parser.hpp"
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -82,33 +83,37 @@ static std::string GetSteamUserDataPath() {
     return "";
 }
 
-static std::string ExtractVdfValue(const std::string& line, const std::string& key) {
-    std::string search = "\"" + key + "\"";
-    size_t pos = line.find(search);
-    if (pos == std::string::npos) return "";
-    size_t p1 = line.find('"', pos + search.size());
-    if (p1 == std::string::npos) return "";
-    size_t p2 = line.find('"', p1 + 1);
-    if (p2 == std::string::npos) return "";
-    return line.substr(p1 + 1, p2 - p1 - 1);
+// loginusers.vdf: "users" { "<SteamID64>" { "PersonaName" ... "MostRecent" "1" } }.
+// Picks the MostRecent account, else the first one listed.
+static bool ReadLoginUser(std::string& persona, std::string& steamId) {
+    std::string steamPath = GetSteamInstallPath();
+    if (steamPath.empty()) return false;
+
+    VdfDocument doc;
+    if (!doc.Load(steamPath + "\\config\\loginusers.vdf")) return false;
+    VdfNode users = doc.Root().Find("users");
+
+    VdfNode pick;
+    for (VdfNode u = users.FirstChild(); u; u = u.Next()) {
+        if (!u.IsObject()) continue;
+        if (!pick) pick = u;
+        if (u.Get("MostRecent") == "1") { pick = u; break; }
+    }
+    if (!pick) return false;
+    persona = pick.Find("PersonaName").String();
+    steamId = std::string(pick.Key());
+    return !persona.empty();
 }
 
 // ─── Data functions ───────────────────────────────────────────────────────────
 
 SteamProfile GetSteamProfile() {
     SteamProfile profile;
-    std::string steamPath = GetSteamInstallPath();
-    if (steamPath.empty()) return profile;
-
-    std::string vdfPath = steamPath + "\\config\\loginusers.vdf";
-    std::ifstream vdf(vdfPath);
-    if (!vdf.is_open()) return profile;
+    std::string name, id;
+    if (!ReadLoginUser(name, id)) return profile;
 
-    std::string line;
-    while (std::getline(vdf, line)) {
-        std::string name = ExtractVdfValue(line, "PersonaName");
-        if (!name.empty()) { profile.username = name; break; }
-    }
+    profile.username      = name;
+    profile.steamID       = id;
     profile.status        = "Online";
     profile.profileLoaded = true;
     return profile;
@@ -141,34 +146,20 @@ std::vector<ResumeEntry> GetRecentGames() {
     std::string userDataPath = GetSteamUserDataPath();
     if (userDataPath.empty()) return entries;
 
-    std::string localCfgPath = userDataPath + "\\config\\localconfig.vdf";
-    std::ifstream f(localCfgPath);
-    if (!f.is_open()) return entries;
-
-    std::string line, currentAppId, currentName;
-    int currentHours = 0;
-    bool inApps = false;
-
-    while (std::getline(f, line)) {
-        if (line.find("\"apps\"") != std::string::npos) { inApps = true; continue; }
-        if (!inApps) continue;
-
-        if (line.find("\"LastPlayed\"") != std::string::npos) {
-            std::string val = ExtractVdfValue(line, "LastPlayed");
-            if (!val.empty() && !currentAppId.empty()) {
-                ResumeEntry e;
-                e.gameName       = currentAppId;
-                e.lastPlayedTime = "Recently";
-                e.hoursPlayed    = currentHours;
-                e.isRecentlyPlayed = true;
-                entries.push_back(e);
-            }
-            currentAppId = ""; currentHours = 0;
-        }
-        if (line.find("\"Playtime2wks\"") != std::string::npos) {
-            std::string val = ExtractVdfValue(line, "Playtime2wks");
-            if (!val.empty()) currentHours = std::stoi(val) / 60;
-        }
+    // localconfig.vdf runs to several MB; it is mapped and tokenized in place,
+    // and only the apps block is ever walked.
+    VdfDocument doc;
+    if (!doc.Load(userDataPath + "\\config\\localconfig.vdf")) return entries;
+    VdfNode apps = doc.Root().Path("UserLocalConfigStore", "Software", "Valve", "Steam", "apps");
+
+    for (VdfNode app = apps.FirstChild(); app; app = app.Next()) {
+        if (!app.IsObject() || app.Get("LastPlayed").empty()) continue;
+        ResumeEntry e;
+        e.gameName         = std::string(app.Key());
+        e.lastPlayedTime   = "Recently";
+        e.hoursPlayed      = atoi(std::string(app.Get("Playtime2wks")).c_str()) / 60;
+        e.isRecentlyPlayed = true;
+        entries.push_back(e);
     }
     return entries;
 }
@@ -186,15 +177,7 @@ std::vector<GamingAccount> GetGamingAccounts() {
         acc.accentColor = { 102/255.f, 192/255.f, 244/255.f, 1.f };
         std::string steamPath = GetSteamInstallPath();
         bool installed = !steamPath.empty();
-        if (installed) {
-            std::string vdfPath = steamPath + "\\config\\loginusers.vdf";
-            std::ifstream vdf(vdfPath);
-            std::string line;
-            while (std::getline(vdf, line)) {
-                std::string name = ExtractVdfValue(line, "PersonaName");
-                if (!name.empty()) { acc.username = name; break; }
-            }
-        }
+        if (installed) ReadLoginUser(acc.username, acc.userId);
         acc.isConnected = installed && !acc.username.empty();
         acc.statusText  = acc.isConnected ? "Connected" : "Click to sign in";
         accounts.push_back(acc);
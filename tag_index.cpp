@@ -0,0 +1,324 @@
+// ============================================================================
+// TAG_INDEX.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "tag_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static const size_t WORDS = 65536 / 64;
+
+unsigned TagBitmap::Ctz(uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward64(&i, v);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctzll(v);
+#endif
+}
+
+static uint32_t Popcount(uint64_t v) {
+#ifdef _MSC_VER
+    return (uint32_t)__popcnt64(v);
+#else
+    return (uint32_t)__builtin_popcountll(v);
+#endif
+}
+
+// ─── Containers ──────────────────────────────────────────────────────────────
+
+TagBitmap::Container* TagBitmap::Find(uint16_t key) {
+    auto it = std::lower_bound(m_c.begin(), m_c.end(), key, [](const Container& c, uint16_t k) { return c.key < k; });
+    return (it != m_c.end() && it->key == key) ? &*it : nullptr;
+}
+
+const TagBitmap::Container* TagBitmap::Find(uint16_t key) const {
+    return const_cast<TagBitmap*>(this)->Find(key);
+}
+
+void TagBitmap::ToWords(const Container& c, std::vector<uint64_t>& out) {
+    if (!c.words.empty()) { out = c.words; return; }
+    out.assign(WORDS, 0);
+    for (uint16_t v : c.array) out[v >> 6] |= 1ull << (v & 63);
+}
+
+void TagBitmap::Optimize(Container& c) {
+    if (c.words.empty() || c.card > ARRAY_MAX) return;
+    c.array.clear();
+    c.array.reserve(c.card);
+    for (size_t w = 0; w < WORDS; w++)
+        for (uint64_t bits = c.words[w]; bits; bits &= bits - 1)
+            c.array.push_back((uint16_t)(w * 64 + Ctz(bits)));
+    c.words.clear();
+    c.words.shrink_to_fit();
+}
+
+void TagBitmap::Add(uint32_t x) {
+    uint16_t hi = (uint16_t)(x >> 16), lo = (uint16_t)x;
+    Container* c = Find(hi);
+    if (!c) {
+        auto it = std::lower_bound(m_c.begin(), m_c.end(), hi, [](const Container& a, uint16_t k) { return a.key < k; });
+        c = &*m_c.insert(it, Container{});
+        c->key = hi;
+    }
+    if (!c->words.empty()) {
+        uint64_t& w = c->words[lo >> 6];
+        uint64_t  m = 1ull << (lo & 63);
+        if (!(w & m)) { w |= m; c->card++; }
+        return;
+    }
+    auto it = std::lower_bound(c->array.begin(), c->array.end(), lo);
+    if (it != c->array.end() && *it == lo) return;
+    c->array.insert(it, lo);
+    c->card++;
+    if (c->card > ARRAY_MAX) {
+        std::vector<uint64_t> w;
+        ToWords(*c, w);
+        c->words.swap(w);
+        c->array.clear();
+        c->array.shrink_to_fit();
+    }
+}
+
+void TagBitmap::Remove(uint32_t x) {
+    uint16_t hi = (uint16_t)(x >> 16), lo = (uint16_t)x;
+    Container* c = Find(hi);
+    if (!c) return;
+    if (!c->words.empty()) {
+        uint64_t& w = c->words[lo >> 6];
+        uint64_t  m = 1ull << (lo & 63);
+        if (!(w & m)) return;
+        w &= ~m;
+        c->card--;
+        Optimize(*c);
+    } else {
+        auto it = std::lower_bound(c->array.begin(), c->array.end(), lo);
+        if (it == c->array.end() || *it != lo) return;
+        c->array.erase(it);
+        c->card--;
+    }
+    if (c->card == 0) m_c.erase(m_c.begin() + (c - m_c.data()));
+}
+
+bool TagBitmap::Contains(uint32_t x) const {
+    const Container* c = Find((uint16_t)(x >> 16));
+    if (!c) return false;
+    uint16_t lo = (uint16_t)x;
+    if (!c->words.empty()) return (c->words[lo >> 6] >> (lo & 63)) & 1;
+    return std::binary_search(c->array.begin(), c->array.end(), lo);
+}
+
+size_t TagBitmap::Cardinality() const {
+    size_t n = 0;
+    for (const auto& c : m_c) n += c.card;
+    return n;
+}
+
+void TagBitmap::EraseShift(uint32_t x) {
+    // Removals are rare; a rebuild keeps every container canonical.
+    TagBitmap out;
+    ForEach([&](uint32_t v) {
+        if (v < x) out.Add(v);
+        else if (v > x) out.Add(v - 1);
+    });
+    m_c.swap(out.m_c);
+}
+
+TagBitmap TagBitmap::Range(uint32_t n) {
+    TagBitmap r;
+    for (uint32_t base = 0; base < n; base += 65536) {
+        Container c;
+        c.key  = (uint16_t)(base >> 16);
+        c.card = std::min<uint32_t>(65536, n - base);
+        c.words.assign(WORDS, 0);
+        for (uint32_t w = 0; w < c.card / 64; w++) c.words[w] = ~0ull;
+        if (c.card % 64) c.words[c.card / 64] = (1ull << (c.card % 64)) - 1;
+        Optimize(c);
+        r.m_c.push_back(std::move(c));
+    }
+    return r;
+}
+
+// ─── Set operations ──────────────────────────────────────────────────────────
+
+// One container pair. Two arrays merge directly; anything involving a word
+// map is done 64 bits at a time. False when the result is empty.
+bool TagBitmap::Combine(const Container& a, const Container& b, Op op, Container& out) {
+    out.key = a.key;
+    if (a.words.empty() && b.words.empty()) {
+        out.array.clear();
+        switch (op) {
+            case AND:    std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(out.array)); break;
+            case OR:     std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(out.array)); break;
+            case ANDNOT: std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(out.array)); break;
+        }
+        out.card = (uint32_t)out.array.size();
+        if (out.card > ARRAY_MAX) {
+            std::vector<uint64_t> w;
+            ToWords(out, w);
+            out.words.swap(w);
+            out.array.clear();
+        }
+        return out.card != 0;
+    }
+    std::vector<uint64_t> wa, wb;
+    ToWords(a, wa);
+    ToWords(b, wb);
+    out.words.resize(WORDS);
+    uint32_t card = 0;
+    for (size_t i = 0; i < WORDS; i++) {
+        uint64_t w = op == AND ? (wa[i] & wb[i]) : op == OR ? (wa[i] | wb[i]) : (wa[i] & ~wb[i]);
+        out.words[i] = w;
+        card += Popcount(w);
+    }
+    out.card = card;
+    Optimize(out);
+    return card != 0;
+}
+
+TagBitmap TagBitmap::Apply(const TagBitmap& a, const TagBitmap& b, Op op) {
+    TagBitmap r;
+    size_t i = 0, j = 0;
+    while (i < a.m_c.size() || j < b.m_c.size()) {
+        bool hasA = i < a.m_c.size(), hasB = j < b.m_c.size();
+        if (hasA && (!hasB || a.m_c[i].key < b.m_c[j].key)) {
+            if (op != AND) r.m_c.push_back(a.m_c[i]);   // OR / ANDNOT keep a's lone container
+            i++;
+        } else if (hasB && (!hasA || b.m_c[j].key < a.m_c[i].key)) {
+            if (op == OR) r.m_c.push_back(b.m_c[j]);
+            j++;
+        } else {
+            Container c;
+            if (Combine(a.m_c[i], b.m_c[j], op, c)) r.m_c.push_back(std::move(c));
+            i++; j++;
+        }
+    }
+    return r;
+}
+
+TagBitmap TagBitmap::And(const TagBitmap& a, const TagBitmap& b)    { return Apply(a, b, AND); }
+TagBitmap TagBitmap::Or(const TagBitmap& a, const TagBitmap& b)     { return Apply(a, b, OR); }
+TagBitmap TagBitmap::AndNot(const TagBitmap& a, const TagBitmap& b) { return Apply(a, b, ANDNOT); }
+
+// ─── Tag index ───────────────────────────────────────────────────────────────
+
+std::string TagIndex::Normalize(std::string_view tag) {
+    std::string out;
+    out.reserve(tag.size());
+    for (char c : tag) {
+        if (c >= 'A' && c <= 'Z')          out += (char)(c + 32);
+        else if (c == ' ' || c == '\t')    { if (!out.empty() && out.back() != '-') out += '-'; }
+        else if (c == '|' || c == '\n' || c == '\r' || c == ',') continue;   // separators in the profile
+        else                               out += c;
+    }
+    while (!out.empty() && out.back() == '-') out.pop_back();
+    // Leading filter operators can't start a name.
+    size_t s = out.find_first_not_of("+-|");
+    return s == std::string::npos ? std::string() : out.substr(s);
+}
+
+void TagIndex::Set(const std::string& tag, uint32_t pos, bool on) {
+    std::string t = Normalize(tag);
+    if (t.empty()) return;
+    if (on) { m_tags[t].Add(pos); return; }
+    auto it = m_tags.find(t);
+    if (it == m_tags.end()) return;
+    it->second.Remove(pos);
+    if (it->second.Empty()) m_tags.erase(it);   // the UI lists only tags someone has
+}
+
+void TagIndex::ClearPosition(uint32_t pos, std::string_view prefix) {
+    for (auto it = m_tags.lower_bound(std::string(prefix)); it != m_tags.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+        it->second.Remove(pos);
+        it = it->second.Empty() ? m_tags.erase(it) : std::next(it);
+    }
+}
+
+void TagIndex::ErasePosition(uint32_t pos) {
+    for (auto it = m_tags.begin(); it != m_tags.end();) {
+        it->second.EraseShift(pos);
+        it = it->second.Empty() ? m_tags.erase(it) : std::next(it);
+    }
+}
+
+bool TagIndex::Has(const std::string& tag, uint32_t pos) const {
+    const TagBitmap* bm = Find(tag);
+    return bm && bm->Contains(pos);
+}
+
+const TagBitmap* TagIndex::Find(const std::string& tag) const {
+    auto it = m_tags.find(Normalize(tag));
+    return it == m_tags.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> TagIndex::TagsOf(uint32_t pos) const {
+    std::vector<std::string> out;
+    for (auto& [name, bm] : m_tags)
+        if (bm.Contains(pos)) out.push_back(name);
+    return out;
+}
+
+// ─── Filters ─────────────────────────────────────────────────────────────────
+
+TagFilter TagFilter::Parse(std::string_view expr) {
+    TagFilter f;
+    std::istringstream in{ std::string(expr) };
+    for (std::string tok; in >> tok;) {
+        char op = tok[0];
+        std::string name = TagIndex::Normalize(op == '+' || op == '-' || op == '|' ? tok.substr(1) : tok);
+        if (name.empty()) continue;
+        (op == '-' ? f.none : op == '|' ? f.any : f.all).push_back(name);
+    }
+    return f;
+}
+
+std::string TagFilter::ToString() const {
+    std::string s;
+    auto put = [&](const std::vector<std::string>& v, const char* op) {
+        for (auto& t : v) { if (!s.empty()) s += ' '; s += op; s += t; }
+    };
+    put(all, "+");
+    put(any, "|");
+    put(none, "-");
+    return s;
+}
+
+TagBitmap TagFilter::Evaluate(const TagIndex& tags, uint32_t universe) const {
+    static const TagBitmap empty;
+    auto get = [&](const std::string& t) -> const TagBitmap& {
+        const TagBitmap* bm = tags.Find(t);
+        return bm ? *bm : empty;
+    };
+    TagBitmap r;
+    if (!all.empty()) {
+        r = get(all[0]);
+        for (size_t i = 1; i < all.size() && !r.Empty(); i++) r = TagBitmap::And(r, get(all[i]));
+    } else {
+        r = TagBitmap::Range(universe);
+    }
+    if (!any.empty()) {
+        TagBitmap u;
+        for (auto& t : any) u = TagBitmap::Or(u, get(t));
+        r = TagBitmap::And(r, u);
+    }
+    for (auto& t : none) r = TagBitmap::AndNot(r, get(t));
+    return r;
+}
+
+bool TagFilter::Matches(const TagIndex& tags, uint32_t pos) const {
+    auto has = [&](const std::string& t) {   // filter tags are stored normalised
+        auto it = tags.All().find(t);
+        return it != tags.All().end() && it->second.Contains(pos);
+    };
+    for (auto& t : all)  if (!has(t)) return false;
+    for (auto& t : none) if (has(t))  return false;
+    return any.empty() || std::any_of(any.begin(), any.end(), has);
+}
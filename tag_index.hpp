@@ -0,0 +1,116 @@
+// ============================================================================
+// TAG_INDEX.HPP - Q-SHELL v3.0
+// Tags and collections over the library, as compressed bitmaps.
+//
+// Membership is a roaring-style bitmap over library positions: values are
+// split by their high 16 bits into containers, and each container is a
+// sorted uint16 array while sparse (up to 4096 members) or a 65536-bit word
+// map once dense. Filters combine tags container by container with
+// 64-bit word operations, so AND / OR / NOT over the whole library costs a
+// few thousand word ops rather than a walk over every entry.
+//
+// Tag names are case-folded and spaces become '-'. Automatic tags carry a
+// prefix ("platform:steam", "drive:d", "played:month"); user collections
+// are bare names. The owner mirrors the library like LibraryIndex: Set on
+// add / change, ErasePosition alongside vector::erase.
+//
+// Filter syntax, whitespace separated:
+//   tag  or +tag   entry must have the tag       (AND)
+//   |tag           entry must have one of these  (OR group)
+//   -tag           entry must not have the tag   (NOT)
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TagBitmap {
+public:
+    void   Add(uint32_t x);
+    void   Remove(uint32_t x);
+    bool   Contains(uint32_t x) const;
+    size_t Cardinality() const;
+    bool   Empty() const { return m_c.empty(); }
+    void   Clear() { m_c.clear(); }
+
+    // Drops x and moves every larger value down by one (vector::erase).
+    void EraseShift(uint32_t x);
+
+    static TagBitmap Range(uint32_t n);   // { 0 .. n-1 }
+    static TagBitmap And(const TagBitmap& a, const TagBitmap& b);
+    static TagBitmap Or(const TagBitmap& a, const TagBitmap& b);
+    static TagBitmap AndNot(const TagBitmap& a, const TagBitmap& b);
+
+    // Calls f(value) in ascending order.
+    template <class F> void ForEach(F f) const {
+        for (const auto& c : m_c) {
+            uint32_t hi = (uint32_t)c.key << 16;
+            if (c.words.empty()) {
+                for (uint16_t v : c.array) f(hi | v);
+            } else {
+                for (size_t w = 0; w < c.words.size(); w++)
+                    for (uint64_t bits = c.words[w]; bits; bits &= bits - 1)
+                        f(hi | (uint32_t)(w * 64 + Ctz(bits)));
+            }
+        }
+    }
+
+private:
+    struct Container {
+        uint16_t              key  = 0;
+        uint32_t              card = 0;
+        std::vector<uint16_t> array;   // sorted; used while words is empty
+        std::vector<uint64_t> words;   // 1024 words once dense
+    };
+    enum Op { AND, OR, ANDNOT };
+
+    static const uint32_t ARRAY_MAX = 4096;
+    static unsigned Ctz(uint64_t v);
+    static void     ToWords(const Container& c, std::vector<uint64_t>& out);
+    static void     Optimize(Container& c);   // back to an array when sparse
+    static bool     Combine(const Container& a, const Container& b, Op op, Container& out);
+    static TagBitmap Apply(const TagBitmap& a, const TagBitmap& b, Op op);
+    Container*       Find(uint16_t key);
+    const Container* Find(uint16_t key) const;
+
+    std::vector<Container> m_c;   // sorted by key
+};
+
+class TagIndex {
+public:
+    void Clear() { m_tags.clear(); }
+
+    void Set(const std::string& tag, uint32_t pos, bool on);
+    void ClearPosition(uint32_t pos, std::string_view prefix);   // every tag starting with prefix
+    void ErasePosition(uint32_t pos);
+    void Drop(const std::string& tag) { m_tags.erase(Normalize(tag)); }
+
+    bool                     Has(const std::string& tag, uint32_t pos) const;
+    const TagBitmap*         Find(const std::string& tag) const;
+    std::vector<std::string> TagsOf(uint32_t pos) const;
+    const std::map<std::string, TagBitmap>& All() const { return m_tags; }
+
+    static std::string Normalize(std::string_view tag);
+
+private:
+    std::map<std::string, TagBitmap> m_tags;   // ordered: listed A-Z in the UI
+};
+
+struct TagFilter {
+    std::vector<std::string> all, any, none;
+
+    static TagFilter Parse(std::string_view expr);
+    std::string      ToString() const;
+    bool             Empty() const { return all.empty() && any.empty() && none.empty(); }
+
+    // Matching positions among 0 .. universe-1.
+    TagBitmap Evaluate(const TagIndex& tags, uint32_t universe) const;
+
+    // Whether one position matches: a Contains per filter tag, for keeping a
+    // filtered view current as single entries change.
+    bool Matches(const TagIndex& tags, uint32_t pos) const;
+};
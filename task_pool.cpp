@@ -0,0 +1,67 @@
+// ============================================================================
+// TASK_POOL.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "task_pool.hpp"
+
+#include <algorithm>
+
+unsigned TaskPool::DefaultThreads() {
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw == 0) hw = 4;
+    return std::clamp(hw, 2u, 8u);
+}
+
+TaskPool::TaskPool(unsigned threads) {
+    if (threads == 0) threads = DefaultThreads();
+    m_threads.reserve(threads);
+    for (unsigned i = 0; i < threads; i++)
+        m_threads.emplace_back(&TaskPool::WorkerLoop, this);
+}
+
+TaskPool::~TaskPool() {
+    Wait();
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_stop = true;
+    }
+    m_work.notify_all();
+    for (auto& t : m_threads) if (t.joinable()) t.join();
+}
+
+void TaskPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> l(m_mutex);
+        m_queue.push_back(std::move(job));
+        m_pending++;
+    }
+    m_work.notify_one();
+}
+
+void TaskPool::Wait() {
+    std::unique_lock<std::mutex> l(m_mutex);
+    m_idle.wait(l, [this] { return m_pending == 0; });
+}
+
+void TaskPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> l(m_mutex);
+            m_work.wait(l, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;   // m_stop and nothing left
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // A throwing job must not take the worker (and the whole scan) down.
+        try { job(); } catch (...) {}
+
+        bool idle;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            idle = (--m_pending == 0);
+        }
+        if (idle) m_idle.notify_all();
+    }
+}
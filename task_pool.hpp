@@ -0,0 +1,43 @@
+// ============================================================================
+// TASK_POOL.HPP - Q-SHELL v3.0
+// Small bounded worker pool used by the library scanner.
+// ============================================================================
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskPool {
+public:
+    // threads == 0 picks DefaultThreads()
+    explicit TaskPool(unsigned threads = 0);
+    ~TaskPool();                       // drains the queue, then joins
+
+    TaskPool(const TaskPool&)            = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    void Submit(std::function<void()> job);
+    void Wait();                       // blocks until every submitted job ran
+
+    unsigned ThreadCount() const { return (unsigned)m_threads.size(); }
+
+    // hardware_concurrency clamped to [2, 8] — scanning is I/O bound, more
+    // threads than that only adds seek contention on spinning disks.
+    static unsigned DefaultThreads();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread>          m_threads;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_work;
+    std::condition_variable           m_idle;
+    unsigned                          m_pending = 0;   // queued + running
+    bool                              m_stop    = false;
+};
@@ -0,0 +1,186 @@
+// ============================================================================
+// VDF_PARSER.CPP - Q-SHELL v3.0
+// ============================================================================
+
+#include "vdf_parser.hpp"
+
+// ─── Tokenizer ───────────────────────────────────────────────────────────────
+
+namespace {
+
+enum class Tok { End, String, Open, Close };
+
+struct Lexer {
+    const char* p;
+    const char* end;
+
+    Tok Next(std::string_view& text, bool& escaped) {
+        escaped = false;
+        for (;;) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+            if (p >= end) return Tok::End;
+
+            if (*p == '/' && p + 1 < end && p[1] == '/') {          // line comment
+                while (p < end && *p != '\n') p++;
+                continue;
+            }
+            if (*p == '[') {                                        // [$WIN32] conditional
+                while (p < end && *p != ']') p++;
+                if (p < end) p++;
+                continue;
+            }
+            break;
+        }
+
+        if (*p == '{') { p++; return Tok::Open; }
+        if (*p == '}') { p++; return Tok::Close; }
+
+        if (*p == '"') {
+            const char* s = ++p;
+            while (p < end && *p != '"') {
+                if (*p == '\\' && p + 1 < end) { escaped = true; p += 2; continue; }
+                p++;
+            }
+            text = std::string_view(s, (size_t)(p - s));
+            if (p < end) p++;   // closing quote; an unterminated string ends at EOF
+            return Tok::String;
+        }
+
+        const char* s = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' &&
+               *p != '{' && *p != '}' && *p != '"') p++;
+        text = std::string_view(s, (size_t)(p - s));
+        return Tok::String;
+    }
+};
+
+inline char Lower(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c; }
+
+bool IEquals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) if (Lower(a[i]) != Lower(b[i])) return false;
+    return true;
+}
+
+} // namespace
+
+std::string VdfUnescape(std::string_view raw) {
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        char c = raw[i];
+        if (c == '\\' && i + 1 < raw.size()) {
+            char n = raw[++i];
+            out += (n == 'n') ? '\n' : (n == 't') ? '\t' : n;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// ─── Document ────────────────────────────────────────────────────────────────
+
+bool VdfDocument::Parse(std::string_view text) {
+    m_nodes.clear();
+    // Real-world VDF averages well over 24 bytes per key; one reservation
+    // usually covers the whole parse.
+    m_nodes.reserve(text.size() / 24 + 1);
+    m_nodes.push_back(Node{});
+    m_nodes[0].object = true;
+
+    // Per open object: its index and its last child (for O(1) sibling append).
+    struct Frame { uint32_t node, last; };
+    std::vector<Frame> stack;
+    stack.reserve(16);
+    stack.push_back({ 0, NONE });
+
+    auto append = [&](Node n) -> uint32_t {
+        uint32_t idx = (uint32_t)m_nodes.size();
+        m_nodes.push_back(n);
+        Frame& f = stack.back();
+        if (f.last == NONE) m_nodes[f.node].firstChild = idx;
+        else                m_nodes[f.last].nextSibling = idx;
+        f.last = idx;
+        return idx;
+    };
+
+    Lexer lx{ text.data(), text.data() + text.size() };
+    std::string_view tok;
+    bool esc;
+    for (;;) {
+        Tok t = lx.Next(tok, esc);
+        if (t == Tok::End) break;
+        if (t == Tok::Close) {
+            if (stack.size() > 1) stack.pop_back();
+            continue;
+        }
+        if (t == Tok::Open) continue;   // stray brace: ignore
+
+        Node n;
+        n.key = tok;
+        Tok v = lx.Next(tok, esc);
+        if (v == Tok::String) {
+            n.value   = tok;
+            n.escaped = esc;
+            append(n);
+        } else if (v == Tok::Open) {
+            n.object = true;
+            uint32_t idx = append(n);
+            stack.push_back({ idx, NONE });
+        } else {
+            if (v == Tok::Close && stack.size() > 1) stack.pop_back();
+            if (v == Tok::End) break;
+        }
+    }
+    return m_nodes.size() > 1;
+}
+
+bool VdfDocument::Load(const std::string& path) {
+    m_nodes.clear();
+    if (!m_file.Open(path)) return false;
+    return Parse(m_file.View());
+}
+
+// ─── Node accessors ──────────────────────────────────────────────────────────
+
+std::string_view VdfNode::Key() const {
+    return m_doc ? m_doc->m_nodes[m_idx].key : std::string_view();
+}
+
+std::string_view VdfNode::RawValue() const {
+    return m_doc ? m_doc->m_nodes[m_idx].value : std::string_view();
+}
+
+std::string VdfNode::String() const {
+    if (!m_doc) return "";
+    const auto& n = m_doc->m_nodes[m_idx];
+    return n.escaped ? VdfUnescape(n.value) : std::string(n.value);
+}
+
+bool VdfNode::IsObject() const {
+    return m_doc && m_doc->m_nodes[m_idx].object;
+}
+
+VdfNode VdfNode::FirstChild() const {
+    if (!m_doc) return {};
+    uint32_t c = m_doc->m_nodes[m_idx].firstChild;
+    return c == VdfDocument::NONE ? VdfNode() : VdfNode(m_doc, c);
+}
+
+VdfNode VdfNode::Next() const {
+    if (!m_doc) return {};
+    uint32_t s = m_doc->m_nodes[m_idx].nextSibling;
+    return s == VdfDocument::NONE ? VdfNode() : VdfNode(m_doc, s);
+}
+
+VdfNode VdfNode::Find(std::string_view key) const {
+    for (VdfNode c = FirstChild(); c; c = c.Next())
+        if (IEquals(c.Key(), key)) return c;
+    return {};
+}
+
+std::string_view VdfNode::Get(std::string_view key) const {
+    VdfNode c = Find(key);
+    return (c && !c.IsObject()) ? c.RawValue() : std::string_view();
+}
@@ -0,0 +1,83 @@
+// ============================================================================
+// VDF_PARSER.HPP - Q-SHELL v3.0
+// Text VDF / ACF (Valve KeyValues) tokenizer and read-only DOM.
+//
+// Keys and values are std::string_view slices of the source buffer; nothing
+// is copied or unescaped until String() is called on a node. Nodes live in
+// one flat vector linked first-child / next-sibling, so a parse costs one
+// amortised vector growth and no allocation per token. Child lookup is a
+// case-insensitive walk of the sibling chain (Steam is inconsistent about
+// "apps" vs "Apps"), done only when asked.
+// ============================================================================
+
+#pragma once
+
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class VdfDocument;
+
+class VdfNode {
+public:
+    VdfNode() = default;
+
+    explicit operator bool() const { return m_doc != nullptr; }
+
+    std::string_view Key()      const;
+    std::string_view RawValue() const;   // escapes left in place
+    std::string      String()   const;   // unescaped copy of the value
+    bool             IsObject() const;
+
+    VdfNode FirstChild() const;
+    VdfNode Next()       const;
+    VdfNode Find(std::string_view key) const;   // case-insensitive, direct children
+
+    // Find(k1).Find(k2)... ; an invalid node if any step is missing.
+    template <class... K> VdfNode Path(std::string_view first, K... rest) const {
+        VdfNode n = Find(first);
+        if constexpr (sizeof...(rest) == 0) return n;
+        else return n ? n.Path(rest...) : VdfNode();
+    }
+
+    // Value of a direct child, or "" if it is absent / an object.
+    std::string_view Get(std::string_view key) const;
+
+private:
+    friend class VdfDocument;
+    VdfNode(const VdfDocument* d, uint32_t i) : m_doc(d), m_idx(i) {}
+    const VdfDocument* m_doc = nullptr;
+    uint32_t           m_idx = 0;
+};
+
+class VdfDocument {
+public:
+    // Parses a caller-owned buffer; it must outlive the document.
+    bool Parse(std::string_view text);
+    // Maps the file and parses it; the mapping is owned by the document.
+    bool Load(const std::string& path);
+
+    // Synthetic root whose children are the top-level keys.
+    VdfNode Root() const { return m_nodes.empty() ? VdfNode() : VdfNode(this, 0); }
+
+private:
+    friend class VdfNode;
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    struct Node {
+        std::string_view key, value;
+        uint32_t firstChild  = NONE;
+        uint32_t nextSibling = NONE;
+        bool     object      = false;
+        bool     escaped     = false;   // value contains backslash escapes
+    };
+
+    std::vector<Node> m_nodes;
+    MappedFile        m_file;
+};
+
+// Undoes \\ \" \n \t escapes.
+std::string VdfUnescape(std::string_view raw);